@@ -0,0 +1,45 @@
+#ifndef XGL_BATCH_H
+#define XGL_BATCH_H
+
+#include "Tool.h"
+#include "SIMD.h"
+#include "Matrix.h"
+
+namespace XGL
+{
+	// Transforms whole arrays of 3-component records by a Mat4 in one call.
+	// Records are read and written as 3 floats that sit stride bytes apart, so an interleaved vertex buffer
+	// such as the one built by Object::genBuffer can be passed directly with the attribute offset added to
+	// the pointer. A stride of 0 means tightly packed. in and out may be the same buffer.
+	class Batch
+	{
+		public:
+			enum ERROR { INVALID_STRIDE };
+
+			// arrays below this many records per thread are not worth splitting
+			static const size_t minParallelCount = 16384;
+
+		private:
+			static size_t checkStride(size_t stride, const char* caller);
+
+			static void pointsKernel(const Mat4& mat, const char* in, char* out, size_t begin, size_t end, size_t inStride, size_t outStride);
+			static void normalsKernel(const Mat4& mat, const char* in, char* out, size_t begin, size_t end, size_t inStride, size_t outStride);
+
+			template<typename F>
+			static void parallelFor(size_t n, unsigned int threadCount, F kernel);
+
+		public:
+			// points are extended with w = 1, the projective row of mat is ignored
+			static void transformPoints(const Mat4& mat, const float* in, float* out, size_t n, size_t inStride = 0, size_t outStride = 0);
+			// normals are extended with w = 0 and renormalized, pass the inverse transpose for non-uniform scaling
+			static void transformNormals(const Mat4& mat, const float* in, float* out, size_t n, size_t inStride = 0, size_t outStride = 0);
+
+			// same results split over threadCount threads, 0 uses every hardware thread
+			static void transformPointsParallel(const Mat4& mat, const float* in, float* out, size_t n, size_t inStride = 0, size_t outStride = 0, unsigned int threadCount = 0);
+			static void transformNormalsParallel(const Mat4& mat, const float* in, float* out, size_t n, size_t inStride = 0, size_t outStride = 0, unsigned int threadCount = 0);
+	};
+}
+
+#include "Batch.inl"
+
+#endif // !XGL_BATCH_H
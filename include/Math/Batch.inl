@@ -0,0 +1,147 @@
+#ifndef XGL_BATCH_INL
+#define XGL_BATCH_INL
+
+#include "Batch.h"
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+namespace XGL
+{
+	inline size_t Batch::checkStride(size_t stride, const char* caller)
+	{
+		if (stride == 0)
+			return 3 * sizeof(float);
+		if (stride < 3 * sizeof(float))
+		{
+			std::cerr << "ERROR | XGL::Batch::" << caller << " : Stride is smaller than a record.\n";
+			throw INVALID_STRIDE;
+		}
+		return stride;
+	}
+
+	inline void Batch::pointsKernel(const Mat4& mat, const char* in, char* out, size_t begin, size_t end, size_t inStride, size_t outStride)
+	{
+		const float* m = mat.getData();
+#ifdef XGL_SIMD_SSE
+		__m128 col0 = _mm_loadu_ps(m + 0);
+		__m128 col1 = _mm_loadu_ps(m + 4);
+		__m128 col2 = _mm_loadu_ps(m + 8);
+		__m128 col3 = _mm_loadu_ps(m + 12);
+		for (size_t i = begin; i < end; i++)
+		{
+			const float* p = (const float*)(in + i * inStride);
+			float* q = (float*)(out + i * outStride);
+			__m128 sum = _mm_mul_ps(col0, _mm_set1_ps(p[0]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(col1, _mm_set1_ps(p[1])));
+			sum = _mm_add_ps(sum, _mm_mul_ps(col2, _mm_set1_ps(p[2])));
+			sum = _mm_add_ps(sum, col3);
+			// only 3 floats are written, the rest of the record may hold other attributes
+			_mm_storel_pi((__m64*)q, sum);
+			_mm_store_ss(q + 2, _mm_movehl_ps(sum, sum));
+		}
+#else
+		for (size_t i = begin; i < end; i++)
+		{
+			const float* p = (const float*)(in + i * inStride);
+			float* q = (float*)(out + i * outStride);
+			float x = p[0], y = p[1], z = p[2];
+			for (size_t r = 0; r < 3; r++)
+				q[r] = m[r] * x + m[4 + r] * y + m[8 + r] * z + m[12 + r];
+		}
+#endif
+	}
+
+	inline void Batch::normalsKernel(const Mat4& mat, const char* in, char* out, size_t begin, size_t end, size_t inStride, size_t outStride)
+	{
+		const float* m = mat.getData();
+#ifdef XGL_SIMD_SSE
+		__m128 col0 = _mm_loadu_ps(m + 0);
+		__m128 col1 = _mm_loadu_ps(m + 4);
+		__m128 col2 = _mm_loadu_ps(m + 8);
+#endif
+		for (size_t i = begin; i < end; i++)
+		{
+			const float* p = (const float*)(in + i * inStride);
+			float* q = (float*)(out + i * outStride);
+			float res[4];
+#ifdef XGL_SIMD_SSE
+			__m128 sum = _mm_mul_ps(col0, _mm_set1_ps(p[0]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(col1, _mm_set1_ps(p[1])));
+			sum = _mm_add_ps(sum, _mm_mul_ps(col2, _mm_set1_ps(p[2])));
+			_mm_storeu_ps(res, sum);
+#else
+			float x = p[0], y = p[1], z = p[2];
+			for (size_t r = 0; r < 3; r++)
+				res[r] = m[r] * x + m[4 + r] * y + m[8 + r] * z;
+#endif
+			// degenerate normals are passed through rather than aborting the whole batch
+			float len = std::sqrt(res[0] * res[0] + res[1] * res[1] + res[2] * res[2]);
+			if (len == 0)
+				len = 1;
+			q[0] = res[0] / len;
+			q[1] = res[1] / len;
+			q[2] = res[2] / len;
+		}
+	}
+
+	template<typename F>
+	void Batch::parallelFor(size_t n, unsigned int threadCount, F kernel)
+	{
+		if (threadCount == 0)
+			threadCount = std::thread::hardware_concurrency();
+		size_t maxThreads = n / minParallelCount;
+		if (threadCount > maxThreads)
+			threadCount = (unsigned int)maxThreads;
+		if (threadCount <= 1)
+		{
+			kernel(0, n);
+			return;
+		}
+
+		size_t chunk = (n + threadCount - 1) / threadCount;
+		std::vector<std::thread> workers;
+		for (size_t begin = chunk; begin < n; begin += chunk)
+			workers.emplace_back(kernel, begin, begin + chunk < n ? begin + chunk : n);
+		kernel(0, chunk);
+		for (size_t i = 0; i < workers.size(); i++)
+			workers[i].join();
+	}
+
+	inline void Batch::transformPoints(const Mat4& mat, const float* in, float* out, size_t n, size_t inStride, size_t outStride)
+	{
+		inStride = checkStride(inStride, "transformPoints(const Mat4&, const float*, float*, size_t, size_t, size_t)");
+		outStride = checkStride(outStride, "transformPoints(const Mat4&, const float*, float*, size_t, size_t, size_t)");
+		pointsKernel(mat, (const char*)in, (char*)out, 0, n, inStride, outStride);
+	}
+
+	inline void Batch::transformNormals(const Mat4& mat, const float* in, float* out, size_t n, size_t inStride, size_t outStride)
+	{
+		inStride = checkStride(inStride, "transformNormals(const Mat4&, const float*, float*, size_t, size_t, size_t)");
+		outStride = checkStride(outStride, "transformNormals(const Mat4&, const float*, float*, size_t, size_t, size_t)");
+		normalsKernel(mat, (const char*)in, (char*)out, 0, n, inStride, outStride);
+	}
+
+	inline void Batch::transformPointsParallel(const Mat4& mat, const float* in, float* out, size_t n, size_t inStride, size_t outStride, unsigned int threadCount)
+	{
+		inStride = checkStride(inStride, "transformPointsParallel(const Mat4&, const float*, float*, size_t, size_t, size_t, unsigned int)");
+		outStride = checkStride(outStride, "transformPointsParallel(const Mat4&, const float*, float*, size_t, size_t, size_t, unsigned int)");
+		parallelFor(n, threadCount, [&mat, in, out, inStride, outStride](size_t begin, size_t end)
+		{
+			pointsKernel(mat, (const char*)in, (char*)out, begin, end, inStride, outStride);
+		});
+	}
+
+	inline void Batch::transformNormalsParallel(const Mat4& mat, const float* in, float* out, size_t n, size_t inStride, size_t outStride, unsigned int threadCount)
+	{
+		inStride = checkStride(inStride, "transformNormalsParallel(const Mat4&, const float*, float*, size_t, size_t, size_t, unsigned int)");
+		outStride = checkStride(outStride, "transformNormalsParallel(const Mat4&, const float*, float*, size_t, size_t, size_t, unsigned int)");
+		parallelFor(n, threadCount, [&mat, in, out, inStride, outStride](size_t begin, size_t end)
+		{
+			normalsKernel(mat, (const char*)in, (char*)out, begin, end, inStride, outStride);
+		});
+	}
+}
+
+#endif // !XGL_BATCH_INL
@@ -0,0 +1,186 @@
+#ifndef XGL_EXPRESSION_H
+#define XGL_EXPRESSION_H
+
+#include "SIMD.h"
+#include <iostream>
+#include <type_traits>
+
+namespace XGL
+{
+	// Element type, element count and error enum of a container, specialized by Vector and Matrix
+	template<typename R>
+	struct ExprTraits;
+
+	// Lazy element-wise arithmetic shared by Vector and Matrix.
+	// E is the concrete node, R the container it evaluates to. Containers are expressions of
+	// themselves, so a whole arithmetic expression is evaluated in one loop when it is assigned.
+	template<typename E, typename R>
+	class Expression
+	{
+		public:
+			constexpr const E& self() const { return *static_cast<const E*>(this); }
+			constexpr R eval() const { return R(*this); }
+	};
+
+	// Containers are held by reference, nodes and scalars by value
+	template<typename E, typename R>
+	struct ExprOperand { typedef E Type; };
+	template<typename R>
+	struct ExprOperand<R, R> { typedef const R& Type; };
+
+	template<typename R>
+	class ScalarExpr : public Expression<ScalarExpr<R>, R>
+	{
+		public:
+			typedef typename ExprTraits<R>::Elem T;
+			static const bool mayThrow = false;
+			static const bool isScalar = true;
+
+		private:
+			T value;
+
+		public:
+			constexpr ScalarExpr(T value) : value(value) {}
+
+			constexpr T coeff(size_t) const { return value; }
+#ifdef XGL_SIMD_SSE
+			__m128 packet(size_t) const { return _mm_set1_ps(value); }
+#endif
+	};
+
+	struct ExprNeg
+	{
+		template<typename T>
+		static constexpr T apply(T Opnt) { return -Opnt; }
+#ifdef XGL_SIMD_SSE
+		static __m128 apply(__m128 Opnt) { return _mm_xor_ps(Opnt, _mm_set1_ps(-0.0f)); }
+#endif
+	};
+
+	struct ExprAdd
+	{
+		static const bool isDivision = false;
+		template<typename T>
+		static constexpr T apply(T lOpnt, T rOpnt) { return lOpnt + rOpnt; }
+#ifdef XGL_SIMD_SSE
+		static __m128 apply(__m128 lOpnt, __m128 rOpnt) { return _mm_add_ps(lOpnt, rOpnt); }
+#endif
+	};
+
+	struct ExprSub
+	{
+		static const bool isDivision = false;
+		template<typename T>
+		static constexpr T apply(T lOpnt, T rOpnt) { return lOpnt - rOpnt; }
+#ifdef XGL_SIMD_SSE
+		static __m128 apply(__m128 lOpnt, __m128 rOpnt) { return _mm_sub_ps(lOpnt, rOpnt); }
+#endif
+	};
+
+	struct ExprMul
+	{
+		static const bool isDivision = false;
+		template<typename T>
+		static constexpr T apply(T lOpnt, T rOpnt) { return lOpnt * rOpnt; }
+#ifdef XGL_SIMD_SSE
+		static __m128 apply(__m128 lOpnt, __m128 rOpnt) { return _mm_mul_ps(lOpnt, rOpnt); }
+#endif
+	};
+
+	struct ExprDiv
+	{
+		static const bool isDivision = true;
+		template<typename T>
+		static constexpr T apply(T lOpnt, T rOpnt) { return lOpnt / rOpnt; }
+#ifdef XGL_SIMD_SSE
+		static __m128 apply(__m128 lOpnt, __m128 rOpnt) { return _mm_div_ps(lOpnt, rOpnt); }
+#endif
+	};
+
+	template<typename Op, typename E, typename R>
+	class UnaryExpr : public Expression<UnaryExpr<Op, E, R>, R>
+	{
+		public:
+			typedef typename ExprTraits<R>::Elem T;
+			static const bool mayThrow = E::mayThrow;
+			static const bool isScalar = false;
+
+		private:
+			typename ExprOperand<E, R>::Type Opnt;
+
+		public:
+			constexpr UnaryExpr(const E& Opnt) : Opnt(Opnt) {}
+
+			constexpr T coeff(size_t idx) const { return Op::apply(Opnt.coeff(idx)); }
+#ifdef XGL_SIMD_SSE
+			__m128 packet(size_t idx) const { return Op::apply(Opnt.packet(idx)); }
+#endif
+	};
+
+	// Element-wise division by a non-scalar operand checks every divisor as it is evaluated
+	template<typename Op, typename L, typename E, typename R>
+	class BinaryExpr : public Expression<BinaryExpr<Op, L, E, R>, R>
+	{
+		public:
+			typedef typename ExprTraits<R>::Elem T;
+			static const bool checkDivisor = Op::isDivision && !E::isScalar;
+			static const bool mayThrow = L::mayThrow || E::mayThrow || checkDivisor;
+			static const bool isScalar = false;
+
+		private:
+			typename ExprOperand<L, R>::Type lOpnt;
+			typename ExprOperand<E, R>::Type rOpnt;
+
+		public:
+			constexpr BinaryExpr(const L& lOpnt, const E& rOpnt) : lOpnt(lOpnt), rOpnt(rOpnt) {}
+
+			constexpr T coeff(size_t idx) const;
+#ifdef XGL_SIMD_SSE
+			__m128 packet(size_t idx) const;
+#endif
+	};
+
+	template<typename E, typename T, int count>
+	constexpr void exprAssign(T* data, const E& expr);
+
+	// --- operators ---
+
+	template<typename E, typename R>
+	constexpr UnaryExpr<ExprNeg, E, R> operator-(const Expression<E, R>& Opnt);
+
+	template<typename L, typename E, typename R>
+	constexpr BinaryExpr<ExprAdd, L, E, R> operator+(const Expression<L, R>& lOpnt, const Expression<E, R>& rOpnt);
+	template<typename L, typename R>
+	constexpr BinaryExpr<ExprAdd, L, ScalarExpr<R>, R> operator+(const Expression<L, R>& lOpnt, typename ExprTraits<R>::Elem rOpnt);
+	template<typename E, typename R>
+	constexpr BinaryExpr<ExprAdd, ScalarExpr<R>, E, R> operator+(typename ExprTraits<R>::Elem lOpnt, const Expression<E, R>& rOpnt);
+
+	template<typename L, typename E, typename R>
+	constexpr BinaryExpr<ExprSub, L, E, R> operator-(const Expression<L, R>& lOpnt, const Expression<E, R>& rOpnt);
+	template<typename L, typename R>
+	constexpr BinaryExpr<ExprSub, L, ScalarExpr<R>, R> operator-(const Expression<L, R>& lOpnt, typename ExprTraits<R>::Elem rOpnt);
+	template<typename E, typename R>
+	constexpr BinaryExpr<ExprSub, ScalarExpr<R>, E, R> operator-(typename ExprTraits<R>::Elem lOpnt, const Expression<E, R>& rOpnt);
+
+	// element-wise product and quotient of two containers only exist for vectors, Matrix * Matrix is the matrix product
+	template<typename L, typename E, typename R, typename std::enable_if<ExprTraits<R>::elementwise, int>::type = 0>
+	constexpr BinaryExpr<ExprMul, L, E, R> operator*(const Expression<L, R>& lOpnt, const Expression<E, R>& rOpnt);
+	template<typename L, typename R>
+	constexpr BinaryExpr<ExprMul, L, ScalarExpr<R>, R> operator*(const Expression<L, R>& lOpnt, typename ExprTraits<R>::Elem rOpnt);
+	template<typename E, typename R>
+	constexpr BinaryExpr<ExprMul, ScalarExpr<R>, E, R> operator*(typename ExprTraits<R>::Elem lOpnt, const Expression<E, R>& rOpnt);
+
+	template<typename L, typename E, typename R, typename std::enable_if<ExprTraits<R>::elementwise, int>::type = 0>
+	constexpr BinaryExpr<ExprDiv, L, E, R> operator/(const Expression<L, R>& lOpnt, const Expression<E, R>& rOpnt);
+	template<typename L, typename R>
+	constexpr BinaryExpr<ExprDiv, L, ScalarExpr<R>, R> operator/(const Expression<L, R>& lOpnt, typename ExprTraits<R>::Elem rOpnt);
+	template<typename E, typename R>
+	constexpr BinaryExpr<ExprDiv, ScalarExpr<R>, E, R> operator/(typename ExprTraits<R>::Elem lOpnt, const Expression<E, R>& rOpnt);
+
+	template<typename E, typename R>
+	std::ostream& operator<<(std::ostream& output, const Expression<E, R>& rOpnt);
+}
+
+#include "Expression.inl"
+
+#endif // !XGL_EXPRESSION_H
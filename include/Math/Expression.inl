@@ -0,0 +1,159 @@
+#ifndef XGL_EXPRESSION_INL
+#define XGL_EXPRESSION_INL
+
+#include "Expression.h"
+
+namespace XGL
+{
+	template<typename Op, typename L, typename E, typename R>
+	constexpr typename BinaryExpr<Op, L, E, R>::T BinaryExpr<Op, L, E, R>::coeff(size_t idx) const
+	{
+		T divisor = rOpnt.coeff(idx);
+		if (checkDivisor && divisor == 0)
+		{
+			std::cerr << "ERROR | XGL::BinaryExpr::coeff(size_t) : Division by zero.\n";
+			throw ExprTraits<R>::Base::DIVISION_BY_ZERO;
+		}
+		return Op::apply(lOpnt.coeff(idx), divisor);
+	}
+
+#ifdef XGL_SIMD_SSE
+	template<typename Op, typename L, typename E, typename R>
+	__m128 BinaryExpr<Op, L, E, R>::packet(size_t idx) const
+	{
+		__m128 divisor = rOpnt.packet(idx);
+		if (checkDivisor && _mm_movemask_ps(_mm_cmpeq_ps(divisor, _mm_setzero_ps())))
+		{
+			std::cerr << "ERROR | XGL::BinaryExpr::packet(size_t) : Division by zero.\n";
+			throw ExprTraits<R>::Base::DIVISION_BY_ZERO;
+		}
+		return Op::apply(lOpnt.packet(idx), divisor);
+	}
+#endif
+
+	template<typename E, typename T, int count>
+	constexpr void exprEvaluate(T* data, const E& expr)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value && count % 4 == 0)
+		{
+			if (!XGL_CONSTANT_EVALUATED())
+			{
+				for (size_t i = 0; i < count; i += 4)
+					_mm_storeu_ps(data + i, expr.packet(i));
+				return;
+			}
+		}
+#endif
+		for (size_t i = 0; i < count; i++)
+			data[i] = expr.coeff(i);
+	}
+
+	template<typename E, typename T, int count>
+	constexpr void exprAssign(T* data, const E& expr)
+	{
+		// an expression that can throw is evaluated aside so the target is left untouched on error
+		if constexpr (E::mayThrow)
+		{
+			T res[count] = {};
+			exprEvaluate<E, T, count>(res, expr);
+			for (size_t i = 0; i < count; i++)
+				data[i] = res[i];
+		}
+		else
+			exprEvaluate<E, T, count>(data, expr);
+	}
+
+	// --- operators ---
+
+	template<typename E, typename R>
+	constexpr UnaryExpr<ExprNeg, E, R> operator-(const Expression<E, R>& Opnt)
+	{
+		return UnaryExpr<ExprNeg, E, R>(Opnt.self());
+	}
+
+	template<typename L, typename E, typename R>
+	constexpr BinaryExpr<ExprAdd, L, E, R> operator+(const Expression<L, R>& lOpnt, const Expression<E, R>& rOpnt)
+	{
+		return BinaryExpr<ExprAdd, L, E, R>(lOpnt.self(), rOpnt.self());
+	}
+
+	template<typename L, typename R>
+	constexpr BinaryExpr<ExprAdd, L, ScalarExpr<R>, R> operator+(const Expression<L, R>& lOpnt, typename ExprTraits<R>::Elem rOpnt)
+	{
+		return BinaryExpr<ExprAdd, L, ScalarExpr<R>, R>(lOpnt.self(), rOpnt);
+	}
+
+	template<typename E, typename R>
+	constexpr BinaryExpr<ExprAdd, ScalarExpr<R>, E, R> operator+(typename ExprTraits<R>::Elem lOpnt, const Expression<E, R>& rOpnt)
+	{
+		return BinaryExpr<ExprAdd, ScalarExpr<R>, E, R>(lOpnt, rOpnt.self());
+	}
+
+	template<typename L, typename E, typename R>
+	constexpr BinaryExpr<ExprSub, L, E, R> operator-(const Expression<L, R>& lOpnt, const Expression<E, R>& rOpnt)
+	{
+		return BinaryExpr<ExprSub, L, E, R>(lOpnt.self(), rOpnt.self());
+	}
+
+	template<typename L, typename R>
+	constexpr BinaryExpr<ExprSub, L, ScalarExpr<R>, R> operator-(const Expression<L, R>& lOpnt, typename ExprTraits<R>::Elem rOpnt)
+	{
+		return BinaryExpr<ExprSub, L, ScalarExpr<R>, R>(lOpnt.self(), rOpnt);
+	}
+
+	template<typename E, typename R>
+	constexpr BinaryExpr<ExprSub, ScalarExpr<R>, E, R> operator-(typename ExprTraits<R>::Elem lOpnt, const Expression<E, R>& rOpnt)
+	{
+		return BinaryExpr<ExprSub, ScalarExpr<R>, E, R>(lOpnt, rOpnt.self());
+	}
+
+	template<typename L, typename E, typename R, typename std::enable_if<ExprTraits<R>::elementwise, int>::type>
+	constexpr BinaryExpr<ExprMul, L, E, R> operator*(const Expression<L, R>& lOpnt, const Expression<E, R>& rOpnt)
+	{
+		return BinaryExpr<ExprMul, L, E, R>(lOpnt.self(), rOpnt.self());
+	}
+
+	template<typename L, typename R>
+	constexpr BinaryExpr<ExprMul, L, ScalarExpr<R>, R> operator*(const Expression<L, R>& lOpnt, typename ExprTraits<R>::Elem rOpnt)
+	{
+		return BinaryExpr<ExprMul, L, ScalarExpr<R>, R>(lOpnt.self(), rOpnt);
+	}
+
+	template<typename E, typename R>
+	constexpr BinaryExpr<ExprMul, ScalarExpr<R>, E, R> operator*(typename ExprTraits<R>::Elem lOpnt, const Expression<E, R>& rOpnt)
+	{
+		return BinaryExpr<ExprMul, ScalarExpr<R>, E, R>(lOpnt, rOpnt.self());
+	}
+
+	template<typename L, typename E, typename R, typename std::enable_if<ExprTraits<R>::elementwise, int>::type>
+	constexpr BinaryExpr<ExprDiv, L, E, R> operator/(const Expression<L, R>& lOpnt, const Expression<E, R>& rOpnt)
+	{
+		return BinaryExpr<ExprDiv, L, E, R>(lOpnt.self(), rOpnt.self());
+	}
+
+	template<typename L, typename R>
+	constexpr BinaryExpr<ExprDiv, L, ScalarExpr<R>, R> operator/(const Expression<L, R>& lOpnt, typename ExprTraits<R>::Elem rOpnt)
+	{
+		if (rOpnt == 0)
+		{
+			std::cerr << "ERROR | XGL::operator/(const Expression<E, R>&, T) : Division by zero.\n";
+			throw ExprTraits<R>::Base::DIVISION_BY_ZERO;
+		}
+		return BinaryExpr<ExprDiv, L, ScalarExpr<R>, R>(lOpnt.self(), rOpnt);
+	}
+
+	template<typename E, typename R>
+	constexpr BinaryExpr<ExprDiv, ScalarExpr<R>, E, R> operator/(typename ExprTraits<R>::Elem lOpnt, const Expression<E, R>& rOpnt)
+	{
+		return BinaryExpr<ExprDiv, ScalarExpr<R>, E, R>(lOpnt, rOpnt.self());
+	}
+
+	template<typename E, typename R>
+	std::ostream& operator<<(std::ostream& output, const Expression<E, R>& rOpnt)
+	{
+		return output << rOpnt.eval();
+	}
+}
+
+#endif // !XGL_EXPRESSION_INL
@@ -1,7 +1,12 @@
 #ifndef XGL_MATRIX_H
 #define XGL_MATRIX_H
 
+#include "Tool.h"
+#include "SIMD.h"
+#include "Vector.h"
+#include "Expression.h"
 #include <iostream>
+#include <type_traits>
 
 namespace XGL
 {
@@ -9,67 +14,82 @@ namespace XGL
 	class Matrix;
 
 	template<typename T, int rows, int columns, bool major>
-	class IMatrix
+	class IMatrix;
+
+	template<typename T, int rows, int columns, bool major>
+	struct ExprTraits<Matrix<T, rows, columns, major>>
+	{
+		typedef T Elem;
+		typedef IMatrix<T, rows, columns, major> Base;
+		static const int count = rows * columns;
+		static const bool elementwise = false;
+	};
+
+	template<typename T, int rows, int columns, bool major>
+	class IMatrix : public Expression<Matrix<T, rows, columns, major>, Matrix<T, rows, columns, major>>
 	{
 		public:
-			enum ERROR { INVALID_SIZE, OUT_OF_RANGE, DIVISION_BY_ZERO, ZERO_VECTOR };
+			enum ERROR { INVALID_SIZE, OUT_OF_RANGE, DIVISION_BY_ZERO, ZERO_VECTOR, SINGULAR_MATRIX };
 
-		protected:
-			T* data;
+			static const bool mayThrow = false;
+			static const bool isScalar = false;
 
-		public:
-			IMatrix();
-			IMatrix(const IMatrix<T, rows, columns, major>& other);
-			IMatrix(IMatrix<T, rows, columns, major>&& other);
-			~IMatrix() { delete[] data; }
+		protected:
+			alignas(storageAlignment<T>(rows * columns)) T data[rows * columns];
 
-			Matrix<T, rows, columns, major>& operator=(const IMatrix<T, rows, columns, major>& rOpnt);
-			Matrix<T, rows, columns, major>& operator=(IMatrix<T, rows, columns, major>&& rOpnt);
+#ifdef XGL_SIMD_SSE
+			static constexpr bool simdPacked = std::is_same<T, float>::value && rows == 4 && columns == 4;
+#endif
 
-			T& operator()(size_t rowIdx, size_t colIdx) const;
+			static constexpr size_t index(size_t rowIdx, size_t colIdx) { return major ? rowIdx * columns + colIdx : colIdx * rows + rowIdx; }
 
-			Matrix<T, rows, columns, major> operator-() const;
+		public:
+			constexpr IMatrix();
+			template<typename E>
+			constexpr IMatrix(const Expression<E, Matrix<T, rows, columns, major>>& expr);
 
-			Matrix<T, rows, columns, major> operator+(const Matrix<T, rows, columns, major>& rOpnt) const;
-			Matrix<T, rows, columns, major>& operator+=(const Matrix<T, rows, columns, major>& rOpnt);
+			template<typename E>
+			constexpr Matrix<T, rows, columns, major>& operator=(const Expression<E, Matrix<T, rows, columns, major>>& rOpnt);
 
-			Matrix<T, rows, columns, major> operator-(const Matrix<T, rows, columns, major>& rOpnt) const;
-			Matrix<T, rows, columns, major>& operator-=(const Matrix<T, rows, columns, major>& rOpnt);
+			constexpr T& operator()(size_t rowIdx, size_t colIdx);
+			constexpr const T& operator()(size_t rowIdx, size_t colIdx) const;
 
-			template<int rOpntColumns>
-			Matrix<T, rows, rOpntColumns, major> operator*(const Matrix<T, columns, rOpntColumns, major>& rOpnt) const;
+			// unchecked access regardless of XGL_CHECKED_ACCESS
+			constexpr T& elem(size_t rowIdx, size_t colIdx) { return data[index(rowIdx, colIdx)]; }
+			constexpr const T& elem(size_t rowIdx, size_t colIdx) const { return data[index(rowIdx, colIdx)]; }
 
-			template<bool tarMajor, typename T, int rows, int columns, bool major>
-			friend Matrix<T, rows, columns, tarMajor> matrix_major_cast(Matrix<T, rows, columns, major>& src);
+			// expression evaluation
+			constexpr T coeff(size_t idx) const { return data[idx]; }
+#ifdef XGL_SIMD_SSE
+			__m128 packet(size_t idx) const { return _mm_loadu_ps(data + idx); }
+#endif
 
-			Matrix<T, rows, columns, major> operator+(T rOpnt) const;
-			template<typename T, int rows, int columns, bool major>
-			friend Matrix<T, rows, columns, major> operator+(T lOpnt, const Matrix<T, rows, columns, major>& rOpnt);
-			Matrix<T, rows, columns, major>& operator+=(T rOpnt);
+			template<typename E>
+			constexpr Matrix<T, rows, columns, major>& operator+=(const Expression<E, Matrix<T, rows, columns, major>>& rOpnt);
+			template<typename E>
+			constexpr Matrix<T, rows, columns, major>& operator-=(const Expression<E, Matrix<T, rows, columns, major>>& rOpnt);
 
-			Matrix<T, rows, columns, major> operator-(T rOpnt) const;
-			template<typename T, int rows, int columns, bool major>
-			friend Matrix<T, rows, columns, major> operator-(T lOpnt, const Matrix<T, rows, columns, major>& rOpnt);
-			Matrix<T, rows, columns, major>& operator-=(T rOpnt);
+			constexpr Matrix<T, rows, columns, major>& operator+=(T rOpnt);
+			constexpr Matrix<T, rows, columns, major>& operator-=(T rOpnt);
+			constexpr Matrix<T, rows, columns, major>& operator*=(T rOpnt);
+			constexpr Matrix<T, rows, columns, major>& operator/=(T rOpnt);
 
-			Matrix<T, rows, columns, major> operator*(T rOpnt) const;
-			template<typename T, int rows, int columns, bool major>
-			friend Matrix<T, rows, columns, major> operator*(T lOpnt, const Matrix<T, rows, columns, major>& rOpnt);
-			Matrix<T, rows, columns, major>& operator*=(T rOpnt);
+			template<int rOpntColumns>
+			constexpr Matrix<T, rows, rOpntColumns, major> operator*(const Matrix<T, columns, rOpntColumns, major>& rOpnt) const;
+			constexpr Vector<T, rows> operator*(const Vector<T, columns>& rOpnt) const;
 
-			Matrix<T, rows, columns, major> operator/(T rOpnt) const;
-			template<typename T, int rows, int columns, bool major>
-			friend Matrix<T, rows, columns, major> operator/(T lOpnt, const Matrix<T, rows, columns, major>& rOpnt);
-			Matrix<T, rows, columns, major>& operator/=(T rOpnt);
+			template<bool tarMajor, typename U, int r, int c, bool m>
+			friend constexpr Matrix<U, r, c, tarMajor> matrix_major_cast(const Matrix<U, r, c, m>& src);
 
-			static Matrix<T, columns, rows, major> transpose(const Matrix<T, rows, columns, major>& Opnt);
-			Matrix<T, columns, rows, major> transpose() const;
+			static constexpr Matrix<T, columns, rows, major> transpose(const Matrix<T, rows, columns, major>& Opnt);
+			constexpr Matrix<T, columns, rows, major> transpose() const;
 
-			T* getData() const { return data; }
-			bool getMajor() const { return major; }
+			constexpr T* getData() { return data; }
+			constexpr const T* getData() const { return data; }
+			constexpr bool getMajor() const { return major; }
 
-			template<typename T, int rows, int columns, bool major>
-			friend std::ostream& operator<<(std::ostream& output, const Matrix<T, rows, columns, major>& rOpnt);
+			template<typename U, int r, int c, bool m>
+			friend std::ostream& operator<<(std::ostream& output, const Matrix<U, r, c, m>& rOpnt);
 	};
 
 	template<typename T, int rows, int columns, bool major>
@@ -77,19 +97,43 @@ namespace XGL
 	{
 		public:
 			using IMatrix<T, rows, columns, major>::IMatrix;
+			using IMatrix<T, rows, columns, major>::operator=;
 	};
 
 	template<typename T, int size, bool major>
 	class Matrix<T, size, size, major> : public IMatrix<T, size, size, major>
 	{
+		private:
+			// cofactors of the upper left 3x3 block, returns its determinant
+			T cofactor3x3(Matrix<T, 3, 3, major>& res) const;
+
 		public:
 			using IMatrix<T, size, size, major>::IMatrix;
+			using IMatrix<T, size, size, major>::operator=;
+			using IMatrix<T, size, size, major>::operator*=;
+
+			constexpr Matrix<T, size, size, major>& operator*=(const Matrix<T, size, size, major>& rOpnt);
 
-			Matrix<T, size, size, major>& operator*=(const Matrix<T, size, size, major>& rOpnt);
+			static constexpr Matrix<T, size, size, major> identity();
 
-			static Matrix<T, size, size, major> identity();
+			// LU decomposition with partial pivoting, throws SINGULAR_MATRIX
+			static Matrix<T, size, size, major> inverse(const Matrix<T, size, size, major>& Opnt);
+			Matrix<T, size, size, major> inverse() const;
+			// 4x4 only, assumes the bottom row is ( 0, 0, 0, 1 ) as in any translate / rotate / scale combination
+			Matrix<T, size, size, major> affineInverse() const;
+			// inverse transpose of the upper left 3x3 block, the matrix that carries normals
+			Matrix<T, 3, 3, major> inverseTranspose3x3() const;
 	};
 
+	// matrix products with a lazy operand evaluate it first
+	template<typename L, typename E, typename T, int rows, int columns, int rOpntColumns, bool major,
+		typename std::enable_if<!std::is_same<L, Matrix<T, rows, columns, major>>::value ||
+			!std::is_same<E, Matrix<T, columns, rOpntColumns, major>>::value, int>::type = 0>
+	constexpr Matrix<T, rows, rOpntColumns, major> operator*(const Expression<L, Matrix<T, rows, columns, major>>& lOpnt, const Expression<E, Matrix<T, columns, rOpntColumns, major>>& rOpnt);
+	template<typename L, typename E, typename T, int rows, int columns, bool major,
+		typename std::enable_if<!std::is_same<L, Matrix<T, rows, columns, major>>::value, int>::type = 0>
+	constexpr Vector<T, rows> operator*(const Expression<L, Matrix<T, rows, columns, major>>& lOpnt, const Expression<E, Vector<T, columns>>& rOpnt);
+
 	using Mat2 = Matrix<float, 2, 2, false>;
 	using Mat3 = Matrix<float, 3, 3, false>;
 	using Mat4 = Matrix<float, 4, 4, false>;
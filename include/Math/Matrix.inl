@@ -7,131 +7,121 @@
 namespace XGL
 {
 	template<typename T, int rows, int columns, bool major>
-	IMatrix<T, rows, columns, major>::IMatrix()
+	constexpr IMatrix<T, rows, columns, major>::IMatrix() : data()
 	{
-		if (rows <= 0 || columns <= 0)
-		{
-			std::cerr << "ERROR | XGL::IMatrix::IMatrix() : Invalid size.\n";
-			throw INVALID_SIZE;
-		}
-		data = new T[rows * columns];
-		memset(data, 0, rows * columns * sizeof(T));
+		static_assert(rows > 0 && columns > 0, "XGL::IMatrix : Invalid size.");
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	IMatrix<T, rows, columns, major>::IMatrix(const IMatrix<T, rows, columns, major>& other)
+	constexpr T& IMatrix<T, rows, columns, major>::operator()(size_t rowIdx, size_t colIdx)
 	{
-		data = new T[rows * columns];
-		memcpy(data, other.data, rows * columns * sizeof(T));
+#if XGL_CHECKED_ACCESS
+		if (rowIdx < 0 || rowIdx >= rows || colIdx < 0 || colIdx >= columns)
+		{
+			std::cerr << "ERROR | XGL::IMatrix::operator()(size_t, size_t) : Index out of bounds.\n";
+			throw OUT_OF_RANGE;
+		}
+#endif
+		return data[index(rowIdx, colIdx)];
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	IMatrix<T, rows, columns, major>::IMatrix(IMatrix<T, rows, columns, major>&& other)
+	constexpr const T& IMatrix<T, rows, columns, major>::operator()(size_t rowIdx, size_t colIdx) const
 	{
-		data = other.data;
-		other.data = NULL;
+#if XGL_CHECKED_ACCESS
+		if (rowIdx < 0 || rowIdx >= rows || colIdx < 0 || colIdx >= columns)
+		{
+			std::cerr << "ERROR | XGL::IMatrix::operator()(size_t, size_t) : Index out of bounds.\n";
+			throw OUT_OF_RANGE;
+		}
+#endif
+		return data[index(rowIdx, colIdx)];
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator=(const IMatrix<T, rows, columns, major>& rOpnt)
+	template<typename E>
+	constexpr IMatrix<T, rows, columns, major>::IMatrix(const Expression<E, Matrix<T, rows, columns, major>>& expr) : data()
 	{
-		if (data != rOpnt.data)
-		{
-			delete[] data;
-			data = new T[rows * columns];
-			memcpy(data, rOpnt.data, rows * columns * sizeof(T));
-		}
-		return *static_cast<Matrix<T, rows, columns, major>*>(this);
+		exprAssign<E, T, rows * columns>(data, expr.self());
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator=(IMatrix<T, rows, columns, major>&& rOpnt)
+	template<typename E>
+	constexpr Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator=(const Expression<E, Matrix<T, rows, columns, major>>& rOpnt)
 	{
-		delete[] data;
-		data = rOpnt.data;
-		rOpnt.data = NULL;
+		exprAssign<E, T, rows * columns>(data, rOpnt.self());
 		return *static_cast<Matrix<T, rows, columns, major>*>(this);
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	T& IMatrix<T, rows, columns, major>::operator()(size_t rowIdx, size_t colIdx) const
+	template<typename E>
+	constexpr Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator+=(const Expression<E, Matrix<T, rows, columns, major>>& rOpnt)
 	{
-		if (rowIdx < 0 || rowIdx >= rows || colIdx < 0 || colIdx >= columns)
-		{
-			std::cerr << "ERROR | XGL::IMatrix::operator()(size_t, size_t) : Index out of bounds.\n";
-			throw OUT_OF_RANGE;
-		}
-		if (major)
-			return data[rowIdx * columns + colIdx];
-		else
-			return data[colIdx * rows + rowIdx];
+		return *this = this->self() + rOpnt;
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> IMatrix<T, rows, columns, major>::operator-() const
+	template<typename E>
+	constexpr Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator-=(const Expression<E, Matrix<T, rows, columns, major>>& rOpnt)
 	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-		{
-			res.data[i] = -data[i];
-		}
-		return res;
+		return *this = this->self() - rOpnt;
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> IMatrix<T, rows, columns, major>::operator+(const Matrix<T, rows, columns, major>& rOpnt) const
+	constexpr Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator+=(T rOpnt)
 	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-		{
-			res.data[i] = data[i] + rOpnt.data[i];
-		}
-		return res;
+		return *this = this->self() + rOpnt;
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator+=(const Matrix<T, rows, columns, major>& rOpnt)
+	constexpr Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator-=(T rOpnt)
 	{
-		for (size_t i = 0; i < rows * columns; i++)
-		{
-			data[i] += rOpnt.data[i];
-		}
-		return *static_cast<Matrix<T, rows, columns, major>*>(this);
+		return *this = this->self() - rOpnt;
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> IMatrix<T, rows, columns, major>::operator-(const Matrix<T, rows, columns, major>& rOpnt) const
+	constexpr Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator*=(T rOpnt)
 	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-		{
-			res.data[i] = data[i] - rOpnt.data[i];
-		}
-		return res;
+		return *this = this->self() * rOpnt;
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator-=(const Matrix<T, rows, columns, major>& rOpnt)
+	constexpr Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator/=(T rOpnt)
 	{
-		for (size_t i = 0; i < rows * columns; i++)
+		if (rOpnt == 0)
 		{
-			data[i] -= rOpnt.data[i];
+			std::cerr << "ERROR | XGL::IMatrix::operator/=(T) : Division by zero.\n";
+			throw DIVISION_BY_ZERO;
 		}
-		return *static_cast<Matrix<T, rows, columns, major>*>(this);
+		return *this = this->self() / rOpnt;
 	}
 
 	template<typename T, int rows, int columns, bool major>
 	template<int rOpntColumns>
-	Matrix<T, rows, rOpntColumns, major> IMatrix<T, rows, columns, major>::operator*(const Matrix<T, columns, rOpntColumns, major>& rOpnt) const
+	constexpr Matrix<T, rows, rOpntColumns, major> IMatrix<T, rows, columns, major>::operator*(const Matrix<T, columns, rOpntColumns, major>& rOpnt) const
 	{
 		Matrix<T, rows, rOpntColumns, major> res;
+#ifdef XGL_SIMD_SSE
+		if constexpr (simdPacked && rOpntColumns == 4)
+		{
+			if (!XGL_CONSTANT_EVALUATED())
+			{
+				// row-major storage is the column-major transpose, so the operands swap
+				if (major)
+					SIMD::mat4Mul(rOpnt.getData(), data, res.getData());
+				else
+					SIMD::mat4Mul(data, rOpnt.getData(), res.getData());
+				return res;
+			}
+		}
+#endif
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < rOpntColumns; j++)
 			{
 				for (size_t k = 0; k < columns; k++)
 				{
-					res(i, j) += (*this)(i, k) * rOpnt(k, j);
+					res.elem(i, j) += elem(i, k) * rOpnt.elem(k, j);
 				}
 			}
 		}
@@ -139,182 +129,284 @@ namespace XGL
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> IMatrix<T, rows, columns, major>::operator+(T rOpnt) const
+	constexpr Vector<T, rows> IMatrix<T, rows, columns, major>::operator*(const Vector<T, columns>& rOpnt) const
 	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-			res.data[i] = data[i] + rOpnt;
-		return res;
-	}
-
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> operator+(T lOpnt, const Matrix<T, rows, columns, major>& rOpnt)
-	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-			res.data[i] = lOpnt + rOpnt.data[i];
+		Vector<T, rows> res;
+#ifdef XGL_SIMD_SSE
+		if constexpr (simdPacked)
+		{
+			if (!major && !XGL_CONSTANT_EVALUATED())
+			{
+				SIMD::mat4MulVec4(data, rOpnt.getData(), res.getData());
+				return res;
+			}
+		}
+#endif
+		for (size_t i = 0; i < rows; i++)
+		{
+			for (size_t k = 0; k < columns; k++)
+			{
+				res.elem(i) += elem(i, k) * rOpnt.elem(k);
+			}
+		}
 		return res;
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator+=(T rOpnt)
-	{
-		for (size_t i = 0; i < rows * columns; i++)
-			data[i] += rOpnt;
-		return *static_cast<Matrix<T, rows, columns, major>*>(this);
-	}
-
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> IMatrix<T, rows, columns, major>::operator-(T rOpnt) const
+	constexpr Matrix<T, columns, rows, major> IMatrix<T, rows, columns, major>::transpose(const Matrix<T, rows, columns, major>& Opnt)
 	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-			res.data[i] = data[i] - rOpnt;
+		Matrix<T, columns, rows, major> res;
+#ifdef XGL_SIMD_SSE
+		if constexpr (simdPacked)
+		{
+			if (!XGL_CONSTANT_EVALUATED())
+			{
+				SIMD::mat4Transpose(Opnt.getData(), res.getData());
+				return res;
+			}
+		}
+#endif
+		for (size_t i = 0; i < rows; i++)
+			for (size_t j = 0; j < columns; j++)
+				res.elem(j, i) = Opnt.elem(i, j);
 		return res;
 	}
 
 	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> operator-(T lOpnt, const Matrix<T, rows, columns, major>& rOpnt)
+	constexpr Matrix<T, columns, rows, major> IMatrix<T, rows, columns, major>::transpose() const
 	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-			res.data[i] = lOpnt - rOpnt.data[i];
+		Matrix<T, columns, rows, major> res;
+#ifdef XGL_SIMD_SSE
+		if constexpr (simdPacked)
+		{
+			if (!XGL_CONSTANT_EVALUATED())
+			{
+				SIMD::mat4Transpose(data, res.getData());
+				return res;
+			}
+		}
+#endif
+		for (size_t i = 0; i < rows; i++)
+			for (size_t j = 0; j < columns; j++)
+				res.elem(j, i) = elem(i, j);
 		return res;
 	}
 
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator-=(T rOpnt)
+	template<typename T, int size, bool major>
+	constexpr Matrix<T, size, size, major>& Matrix<T, size, size, major>::operator*=(const Matrix<T, size, size, major>& rOpnt)
 	{
-		for (size_t i = 0; i < rows * columns; i++)
-			data[i] -= rOpnt;
-		return *static_cast<Matrix<T, rows, columns, major>*>(this);
+#ifdef XGL_SIMD_SSE
+		if constexpr (IMatrix<T, size, size, major>::simdPacked)
+		{
+			*this = (*this) * rOpnt;
+			return *this;
+		}
+#endif
+		Matrix<T, size, size, major> res;
+		for (size_t i = 0; i < size; i++)
+		{
+			for (size_t j = 0; j < size; j++)
+			{
+				for (size_t k = 0; k < size; k++)
+				{
+					res.elem(i, j) += this->elem(i, k) * rOpnt.elem(k, j);
+				}
+			}
+		}
+		*this = res;
+		return *this;
 	}
 
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> IMatrix<T, rows, columns, major>::operator*(T rOpnt) const
+	template<typename T, int size, bool major>
+	constexpr Matrix<T, size, size, major> Matrix<T, size, size, major>::identity()
 	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-			res.data[i] = data[i] * rOpnt;
+		Matrix<T, size, size, major> res;
+		for (size_t i = 0; i < size; i++)
+			res.elem(i, i) = 1;
 		return res;
 	}
 
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> operator*(T lOpnt, const Matrix<T, rows, columns, major>& rOpnt)
+	template<typename T, int size, bool major>
+	T Matrix<T, size, size, major>::cofactor3x3(Matrix<T, 3, 3, major>& res) const
 	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-			res.data[i] = lOpnt * rOpnt.data[i];
-		return res;
+		// column j is the cross product of the other two columns
+		for (size_t j = 0; j < 3; j++)
+		{
+			size_t a = (j + 1) % 3, b = (j + 2) % 3;
+			for (size_t i = 0; i < 3; i++)
+			{
+				size_t p = (i + 1) % 3, q = (i + 2) % 3;
+				res.elem(i, j) = this->elem(p, a) * this->elem(q, b) - this->elem(q, a) * this->elem(p, b);
+			}
+		}
+		return this->elem(0, 0) * res.elem(0, 0) + this->elem(1, 0) * res.elem(1, 0) + this->elem(2, 0) * res.elem(2, 0);
 	}
 
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator*=(T rOpnt)
+	template<typename T, int size, bool major>
+	Matrix<T, size, size, major> Matrix<T, size, size, major>::inverse(const Matrix<T, size, size, major>& Opnt)
 	{
-		for (size_t i = 0; i < rows * columns; i++)
-			data[i] *= rOpnt;
-		return *static_cast<Matrix<T, rows, columns, major>*>(this);
+		return Opnt.inverse();
 	}
 
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> IMatrix<T, rows, columns, major>::operator/(T rOpnt) const
+	template<typename T, int size, bool major>
+	Matrix<T, size, size, major> Matrix<T, size, size, major>::inverse() const
 	{
-		if (rOpnt == 0)
+		Matrix<T, size, size, major> res;
+#ifdef XGL_SIMD_SSE
+		if constexpr (IMatrix<T, size, size, major>::simdPacked)
 		{
-			std::cerr << "ERROR | XGL::IMatrix::operator/(T) : Division by zero.\n";
-			throw DIVISION_BY_ZERO;
+			// the inverse of the transpose is the transpose of the inverse, so one kernel serves both layouts
+			if (!SIMD::mat4Inverse(this->data, res.getData()))
+			{
+				std::cerr << "ERROR | XGL::Matrix::inverse() : Singular matrix.\n";
+				throw IMatrix<T, size, size, major>::SINGULAR_MATRIX;
+			}
+			return res;
 		}
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
-			res.data[i] = data[i] / rOpnt;
-		return res;
-	}
-
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major> operator/(T lOpnt, const Matrix<T, rows, columns, major>& rOpnt)
-	{
-		Matrix<T, rows, columns, major> res;
-		for (size_t i = 0; i < rows * columns; i++)
+#endif
+		// LU = PA, with L's unit diagonal implied and both factors stored in lu
+		Matrix<T, size, size, major> lu = *this;
+		size_t perm[size];
+		for (size_t i = 0; i < size; i++)
+			perm[i] = i;
+		for (size_t k = 0; k < size; k++)
 		{
-			if (rOpnt.data[i] == 0)
+			size_t pivot = k;
+			T pivotAbs = lu.elem(k, k) < 0 ? -lu.elem(k, k) : lu.elem(k, k);
+			for (size_t i = k + 1; i < size; i++)
 			{
-				std::cerr << "ERROR | XGL::operator/(T, const Matrix<T, rows, columns, major>&) : Division by zero.\n";
-				throw IMatrix<T, rows, columns, major>::DIVISION_BY_ZERO;
+				T cur = lu.elem(i, k) < 0 ? -lu.elem(i, k) : lu.elem(i, k);
+				if (cur > pivotAbs)
+				{
+					pivot = i;
+					pivotAbs = cur;
+				}
+			}
+			if (pivotAbs == 0)
+			{
+				std::cerr << "ERROR | XGL::Matrix::inverse() : Singular matrix.\n";
+				throw IMatrix<T, size, size, major>::SINGULAR_MATRIX;
+			}
+			if (pivot != k)
+			{
+				for (size_t j = 0; j < size; j++)
+				{
+					T temp = lu.elem(k, j);
+					lu.elem(k, j) = lu.elem(pivot, j);
+					lu.elem(pivot, j) = temp;
+				}
+				size_t temp = perm[k];
+				perm[k] = perm[pivot];
+				perm[pivot] = temp;
+			}
+			for (size_t i = k + 1; i < size; i++)
+			{
+				lu.elem(i, k) /= lu.elem(k, k);
+				for (size_t j = k + 1; j < size; j++)
+					lu.elem(i, j) -= lu.elem(i, k) * lu.elem(k, j);
 			}
-			res.data[i] = lOpnt / rOpnt.data[i];
 		}
-		return res;
-	}
-
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, major>& IMatrix<T, rows, columns, major>::operator/=(T rOpnt)
-	{
-		if (rOpnt == 0)
+		// solve LUx = Pe for every column e of the identity
+		for (size_t j = 0; j < size; j++)
 		{
-			std::cerr << "ERROR | XGL::IMatrix::operator/=(T) : Division by zero.\n";
-			throw DIVISION_BY_ZERO;
+			for (size_t i = 0; i < size; i++)
+			{
+				T sum = perm[i] == j ? 1 : 0;
+				for (size_t k = 0; k < i; k++)
+					sum -= lu.elem(i, k) * res.elem(k, j);
+				res.elem(i, j) = sum;
+			}
+			for (size_t i = size; i-- > 0;)
+			{
+				T sum = res.elem(i, j);
+				for (size_t k = i + 1; k < size; k++)
+					sum -= lu.elem(i, k) * res.elem(k, j);
+				res.elem(i, j) = sum / lu.elem(i, i);
+			}
 		}
-		for (size_t i = 0; i < rows * columns; i++)
-			data[i] /= rOpnt;
-		return *static_cast<Matrix<T, rows, columns, major>*>(this);
-	}
-
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, columns, rows, major> IMatrix<T, rows, columns, major>::transpose(const Matrix<T, rows, columns, major>& Opnt)
-	{
-		Matrix<T, columns, rows, major> res;
-		for (size_t i = 0; i < rows; i++)
-			for (size_t j = 0; j < columns; j++)
-				res(j, i) = Opnt(i, j);
 		return res;
 	}
 
-	template<typename T, int rows, int columns, bool major>
-	Matrix<T, columns, rows, major> IMatrix<T, rows, columns, major>::transpose() const
+	template<typename T, int size, bool major>
+	Matrix<T, size, size, major> Matrix<T, size, size, major>::affineInverse() const
 	{
-		Matrix<T, columns, rows, major> res;
-		for (size_t i = 0; i < rows; i++)
-			for (size_t j = 0; j < columns; j++)
-				res(j, i) = (*this)(i, j);
+		static_assert(size == 4, "XGL::Matrix::affineInverse : Only defined for 4x4 matrices.");
+		Matrix<T, size, size, major> res;
+#ifdef XGL_SIMD_SSE
+		if constexpr (IMatrix<T, size, size, major>::simdPacked && !major)
+		{
+			if (!SIMD::mat4AffineInverse(this->data, res.getData()))
+			{
+				std::cerr << "ERROR | XGL::Matrix::affineInverse() : Singular matrix.\n";
+				throw IMatrix<T, size, size, major>::SINGULAR_MATRIX;
+			}
+			return res;
+		}
+#endif
+		Matrix<T, 3, 3, major> cof;
+		T det = cofactor3x3(cof);
+		if (det == 0)
+		{
+			std::cerr << "ERROR | XGL::Matrix::affineInverse() : Singular matrix.\n";
+			throw IMatrix<T, size, size, major>::SINGULAR_MATRIX;
+		}
+		for (size_t i = 0; i < 3; i++)
+			for (size_t j = 0; j < 3; j++)
+				res.elem(i, j) = cof.elem(j, i) / det;
+		for (size_t i = 0; i < 3; i++)
+			res.elem(i, 3) = -(res.elem(i, 0) * this->elem(0, 3) + res.elem(i, 1) * this->elem(1, 3) + res.elem(i, 2) * this->elem(2, 3));
+		res.elem(3, 3) = 1;
 		return res;
 	}
 
 	template<typename T, int size, bool major>
-	Matrix<T, size, size, major>& Matrix<T, size, size, major>::operator*=(const Matrix<T, size, size, major>& rOpnt)
+	Matrix<T, 3, 3, major> Matrix<T, size, size, major>::inverseTranspose3x3() const
 	{
-		Matrix<T, size, size, major> res;
-		for (size_t i = 0; i < size; i++)
+		static_assert(size >= 3, "XGL::Matrix::inverseTranspose3x3 : Matrix smaller than 3x3.");
+		Matrix<T, 3, 3, major> res;
+#ifdef XGL_SIMD_SSE
+		if constexpr (IMatrix<T, size, size, major>::simdPacked && !major)
 		{
-			for (size_t j = 0; j < size; j++)
+			if (!SIMD::mat4InverseTranspose3(this->data, res.getData()))
 			{
-				for (size_t k = 0; k < size; k++)
-				{
-					res(i, j) += (*this)(i, k) * rOpnt(k, j);
-				}
+				std::cerr << "ERROR | XGL::Matrix::inverseTranspose3x3() : Singular matrix.\n";
+				throw IMatrix<T, size, size, major>::SINGULAR_MATRIX;
 			}
+			return res;
 		}
-		delete[] this->data;
-		this->data = res.data;
-		res.data = NULL;
-		return *static_cast<Matrix<T, size, size, major>*>(this);
+#endif
+		T det = cofactor3x3(res);
+		if (det == 0)
+		{
+			std::cerr << "ERROR | XGL::Matrix::inverseTranspose3x3() : Singular matrix.\n";
+			throw IMatrix<T, size, size, major>::SINGULAR_MATRIX;
+		}
+		res /= det;
+		return res;
 	}
 
-	template<typename T, int size, bool major>
-	Matrix<T, size, size, major> Matrix<T, size, size, major>::identity()
+	template<typename L, typename E, typename T, int rows, int columns, int rOpntColumns, bool major,
+		typename std::enable_if<!std::is_same<L, Matrix<T, rows, columns, major>>::value ||
+			!std::is_same<E, Matrix<T, columns, rOpntColumns, major>>::value, int>::type>
+	constexpr Matrix<T, rows, rOpntColumns, major> operator*(const Expression<L, Matrix<T, rows, columns, major>>& lOpnt, const Expression<E, Matrix<T, columns, rOpntColumns, major>>& rOpnt)
 	{
-		Matrix<T, size, size, major> res;
-		for (size_t i = 0; i < size; i++)
-			res(i, i) = 1;
-		return res;
+		return lOpnt.eval() * rOpnt.eval();
+	}
+
+	template<typename L, typename E, typename T, int rows, int columns, bool major,
+		typename std::enable_if<!std::is_same<L, Matrix<T, rows, columns, major>>::value, int>::type>
+	constexpr Vector<T, rows> operator*(const Expression<L, Matrix<T, rows, columns, major>>& lOpnt, const Expression<E, Vector<T, columns>>& rOpnt)
+	{
+		return lOpnt.eval() * rOpnt.eval();
 	}
 
 	template<bool tarMajor, typename T, int rows, int columns, bool major>
-	Matrix<T, rows, columns, tarMajor> matrix_major_cast(Matrix<T, rows, columns, major>& src)
+	constexpr Matrix<T, rows, columns, tarMajor> matrix_major_cast(const Matrix<T, rows, columns, major>& src)
 	{
 		Matrix<T, rows, columns, tarMajor> res;
 		for (size_t i = 0; i < rows; i++)
 			for (size_t j = 0; j < columns; j++)
-				res(i, j) = src(i, j);
+				res.elem(i, j) = src.elem(i, j);
 		return res;
 	}
 
@@ -327,7 +419,7 @@ namespace XGL
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				output << std::setw(5) << rOpnt(i, j) << ' ';
+				output << std::setw(5) << rOpnt.elem(i, j) << ' ';
 			}
 			output << std::endl;
 		}
@@ -13,17 +13,17 @@ namespace XGL
 
 		public:
 			template<typename T>
-			static Matrix<T, 4, 4, false> orthogonal(T left, T right, T bottom, T top, T near, T far);
+			static constexpr Matrix<T, 4, 4, false> orthogonal(T left, T right, T bottom, T top, T near, T far);
 			template<typename T>
-			static Matrix<T, 4, 4, false> orthoSym(T width, T height, T near, T far);
+			static constexpr Matrix<T, 4, 4, false> orthoSym(T width, T height, T near, T far);
 			template<typename T>
-			static Matrix<T, 4, 4, false> orthoAR(T height, T aspect, T near, T far);
+			static constexpr Matrix<T, 4, 4, false> orthoAR(T height, T aspect, T near, T far);
 			template<typename T>
-			static Matrix<T, 4, 4, false> perspective(T left, T right, T bottom, T top, T near, T far);
+			static constexpr Matrix<T, 4, 4, false> perspective(T left, T right, T bottom, T top, T near, T far);
 			template<typename T>
-			static Matrix<T, 4, 4, false> perspSym(T width, T height, T near, T far);
+			static constexpr Matrix<T, 4, 4, false> perspSym(T width, T height, T near, T far);
 			template<typename T>
-			static Matrix<T, 4, 4, false> perspAR(T height, T aspect, T near, T far);
+			static constexpr Matrix<T, 4, 4, false> perspAR(T height, T aspect, T near, T far);
 			template<typename T>
 			static Matrix<T, 4, 4, false> perspFov(T fovy, T aspect, T near, T far);
 	};
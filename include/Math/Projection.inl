@@ -7,7 +7,7 @@
 namespace XGL
 {
 	template<typename T>
-	Matrix<T, 4, 4, false> Projection::orthogonal(T left, T right, T bottom, T top, T near, T far)
+	constexpr Matrix<T, 4, 4, false> Projection::orthogonal(T left, T right, T bottom, T top, T near, T far)
 	{
 		if (right <= left || top <= bottom || near <= 0 || far <= near)
 		{
@@ -15,18 +15,18 @@ namespace XGL
 			throw INVALID_SIZE;
 		}
 		Matrix<T, 4, 4, false> res;
-		res(0, 0) = 2 / (right - left);
-		res(0, 3) = -(right + left) / (right - left);
-		res(1, 1) = 2 / (top - bottom);
-		res(1, 3) = -(top + bottom) / (top - bottom);
-		res(2, 2) = -2 / (far - near);
-		res(2, 3) = -(far + near) / (far - near);
-		res(3, 3) = 1;
+		res.elem(0, 0) = 2 / (right - left);
+		res.elem(0, 3) = -(right + left) / (right - left);
+		res.elem(1, 1) = 2 / (top - bottom);
+		res.elem(1, 3) = -(top + bottom) / (top - bottom);
+		res.elem(2, 2) = -2 / (far - near);
+		res.elem(2, 3) = -(far + near) / (far - near);
+		res.elem(3, 3) = 1;
 		return res;
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false> Projection::orthoSym(T width, T height, T near, T far)
+	constexpr Matrix<T, 4, 4, false> Projection::orthoSym(T width, T height, T near, T far)
 	{
 		if (width <= 0 || height <= 0 || near <= 0 || far <= near)
 		{
@@ -34,16 +34,16 @@ namespace XGL
 			throw INVALID_SIZE;
 		}
 		Matrix<T, 4, 4, false> res;
-		res(0, 0) = 2 / width;
-		res(1, 1) = 2 / height;
-		res(2, 2) = -2 / (far - near);
-		res(2, 3) = -(far + near) / (far - near);
-		res(3, 3) = 1;
+		res.elem(0, 0) = 2 / width;
+		res.elem(1, 1) = 2 / height;
+		res.elem(2, 2) = -2 / (far - near);
+		res.elem(2, 3) = -(far + near) / (far - near);
+		res.elem(3, 3) = 1;
 		return res;
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false> Projection::orthoAR(T height, T aspect, T near, T far)
+	constexpr Matrix<T, 4, 4, false> Projection::orthoAR(T height, T aspect, T near, T far)
 	{
 		if (height <= 0 || aspect <= 0 || near <= 0 || far <= near)
 		{
@@ -54,7 +54,7 @@ namespace XGL
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false> Projection::perspective(T left, T right, T bottom, T top, T near, T far)
+	constexpr Matrix<T, 4, 4, false> Projection::perspective(T left, T right, T bottom, T top, T near, T far)
 	{
 		if (right <= left || top <= bottom || near <= 0 || far <= near)
 		{
@@ -62,18 +62,18 @@ namespace XGL
 			throw INVALID_SIZE;
 		}
 		Matrix<T, 4, 4, false> res;
-		res(0, 0) = 2 * near / (right - left);
-		res(0, 2) = (right + left) / (right - left);
-		res(1, 1) = 2 * near / (top - bottom);
-		res(1, 2) = (top + bottom) / (top - bottom);
-		res(2, 2) = -(far + near) / (far - near);
-		res(2, 3) = -2 * far * near / (far - near);
-		res(3, 2) = -1;
+		res.elem(0, 0) = 2 * near / (right - left);
+		res.elem(0, 2) = (right + left) / (right - left);
+		res.elem(1, 1) = 2 * near / (top - bottom);
+		res.elem(1, 2) = (top + bottom) / (top - bottom);
+		res.elem(2, 2) = -(far + near) / (far - near);
+		res.elem(2, 3) = -2 * far * near / (far - near);
+		res.elem(3, 2) = -1;
 		return res;
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false> Projection::perspSym(T width, T height, T near, T far)
+	constexpr Matrix<T, 4, 4, false> Projection::perspSym(T width, T height, T near, T far)
 	{
 		if (width <= 0 || height <= 0 || near <= 0 || far <= near)
 		{
@@ -81,16 +81,16 @@ namespace XGL
 			throw INVALID_SIZE;
 		}
 		Matrix<T, 4, 4, false> res;
-		res(0, 0) = 2 * near / width;
-		res(1, 1) = 2 * near / height;
-		res(2, 2) = -(far + near) / (far - near);
-		res(2, 3) = -2 * far * near / (far - near);
-		res(3, 2) = -1;
+		res.elem(0, 0) = 2 * near / width;
+		res.elem(1, 1) = 2 * near / height;
+		res.elem(2, 2) = -(far + near) / (far - near);
+		res.elem(2, 3) = -2 * far * near / (far - near);
+		res.elem(3, 2) = -1;
 		return res;
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false> Projection::perspAR(T height, T aspect, T near, T far)
+	constexpr Matrix<T, 4, 4, false> Projection::perspAR(T height, T aspect, T near, T far)
 	{
 		if (height <= 0 || aspect <= 0 || near <= 0 || far <= near)
 		{
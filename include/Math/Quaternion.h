@@ -0,0 +1,88 @@
+#ifndef XGL_QUATERNION_H
+#define XGL_QUATERNION_H
+
+#include "Tool.h"
+#include "Vector.h"
+#include "Matrix.h"
+#include <iostream>
+
+namespace XGL
+{
+	// Unit quaternion rotations, stored as ( x, y, z, w ) with w the scalar part.
+	// Euler angles follow Transform::rotate(yaw, pitch, roll), the rotation undone by View::euler.
+	template<typename T>
+	class Quaternion
+	{
+		public:
+			enum ERROR { ZERO_QUATERNION };
+
+		private:
+			T data[4];
+
+			template<typename M>
+			static Quaternion<T> fromRotation(const M& mat);
+
+		public:
+			constexpr Quaternion() : data{ 0, 0, 0, 1 } {}
+			constexpr Quaternion(T w, T x, T y, T z) : data{ x, y, z, w } {}
+			constexpr Quaternion(T w, Vector<T, 3> v) : data{ v.x(), v.y(), v.z(), w } {}
+
+			static constexpr Quaternion<T> identity() { return Quaternion<T>(); }
+			static Quaternion<T> fromAxisAngle(T angle, Vector<T, 3> axis);
+			static Quaternion<T> fromEuler(T yaw, T pitch, T roll);
+			static Quaternion<T> fromMatrix(const Matrix<T, 3, 3, false>& mat);
+			static Quaternion<T> fromMatrix(const Matrix<T, 4, 4, false>& mat);
+
+			// ( yaw, pitch, roll )
+			Vector<T, 3> toEuler() const;
+			Matrix<T, 3, 3, false> toMat3() const;
+			Matrix<T, 4, 4, false> toMat4() const;
+
+			constexpr T& x() { return data[0]; }
+			constexpr const T& x() const { return data[0]; }
+			constexpr T& y() { return data[1]; }
+			constexpr const T& y() const { return data[1]; }
+			constexpr T& z() { return data[2]; }
+			constexpr const T& z() const { return data[2]; }
+			constexpr T& w() { return data[3]; }
+			constexpr const T& w() const { return data[3]; }
+			constexpr Vector<T, 3> vec() const { return Vector<T, 3>(data[0], data[1], data[2]); }
+
+			// composition, ( lOpnt * rOpnt ) rotates by rOpnt first
+			constexpr Quaternion<T> operator*(const Quaternion<T>& rOpnt) const;
+			constexpr Quaternion<T>& operator*=(const Quaternion<T>& rOpnt);
+			constexpr Vector<T, 3> operator*(const Vector<T, 3>& rOpnt) const;
+			constexpr Vector<T, 3> rotate(const Vector<T, 3>& rOpnt) const { return (*this) * rOpnt; }
+
+			constexpr Quaternion<T> operator+(const Quaternion<T>& rOpnt) const;
+			constexpr Quaternion<T> operator-() const;
+			constexpr Quaternion<T> operator*(T rOpnt) const;
+
+			constexpr bool operator==(const Quaternion<T>& rOpnt) const;
+			constexpr bool operator!=(const Quaternion<T>& rOpnt) const;
+
+			static constexpr T dot(const Quaternion<T>& lOpnt, const Quaternion<T>& rOpnt);
+			constexpr T norm2() const { return dot(*this, *this); }
+			T norm() const;
+			Quaternion<T> normalize() const;
+			// the inverse of a unit quaternion
+			constexpr Quaternion<T> conjugate() const { return Quaternion<T>(data[3], -data[0], -data[1], -data[2]); }
+			Quaternion<T> inverse() const;
+
+			// normalized linear and spherical interpolation along the shorter arc
+			static Quaternion<T> nlerp(const Quaternion<T>& from, const Quaternion<T>& to, T t);
+			static Quaternion<T> slerp(const Quaternion<T>& from, const Quaternion<T>& to, T t);
+
+			constexpr T* getData() { return data; }
+			constexpr const T* getData() const { return data; }
+
+			template<typename U>
+			friend std::ostream& operator<<(std::ostream& output, const Quaternion<U>& rOpnt);
+	};
+
+	using Quat = Quaternion<float>;
+}
+
+#include "Quaternion.inl"
+
+#endif // !XGL_QUATERNION_H
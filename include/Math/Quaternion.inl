@@ -0,0 +1,261 @@
+#ifndef XGL_QUATERNION_INL
+#define XGL_QUATERNION_INL
+
+#include "Quaternion.h"
+#include <cmath>
+
+namespace XGL
+{
+	template<typename T>
+	Quaternion<T> Quaternion<T>::fromAxisAngle(T angle, Vector<T, 3> axis)
+	{
+		axis = axis.normalize();
+		T s = sin(angle / 2);
+		return Quaternion<T>(cos(angle / 2), axis.x() * s, axis.y() * s, axis.z() * s);
+	}
+
+	template<typename T>
+	Quaternion<T> Quaternion<T>::fromEuler(T yaw, T pitch, T roll)
+	{
+		// Ry(-yaw) * Rx(pitch) * Rz(-roll), expanded
+		T s1 = sin(-yaw / 2), s2 = sin(pitch / 2), s3 = sin(-roll / 2);
+		T c1 = cos(-yaw / 2), c2 = cos(pitch / 2), c3 = cos(-roll / 2);
+		return Quaternion<T>(
+			c1 * c2 * c3 + s1 * s2 * s3,
+			c1 * s2 * c3 + s1 * c2 * s3,
+			s1 * c2 * c3 - c1 * s2 * s3,
+			c1 * c2 * s3 - s1 * s2 * c3);
+	}
+
+	template<typename T>
+	template<typename M>
+	Quaternion<T> Quaternion<T>::fromRotation(const M& mat)
+	{
+		T trace = mat.elem(0, 0) + mat.elem(1, 1) + mat.elem(2, 2);
+		T s;
+		// pivot on the largest of w, x, y, z to keep the square root well conditioned
+		if (trace > 0)
+		{
+			s = sqrt(trace + 1) * 2;
+			return Quaternion<T>(s / 4,
+				(mat.elem(2, 1) - mat.elem(1, 2)) / s,
+				(mat.elem(0, 2) - mat.elem(2, 0)) / s,
+				(mat.elem(1, 0) - mat.elem(0, 1)) / s);
+		}
+		if (mat.elem(0, 0) > mat.elem(1, 1) && mat.elem(0, 0) > mat.elem(2, 2))
+		{
+			s = sqrt(1 + mat.elem(0, 0) - mat.elem(1, 1) - mat.elem(2, 2)) * 2;
+			return Quaternion<T>((mat.elem(2, 1) - mat.elem(1, 2)) / s,
+				s / 4,
+				(mat.elem(0, 1) + mat.elem(1, 0)) / s,
+				(mat.elem(0, 2) + mat.elem(2, 0)) / s);
+		}
+		if (mat.elem(1, 1) > mat.elem(2, 2))
+		{
+			s = sqrt(1 + mat.elem(1, 1) - mat.elem(0, 0) - mat.elem(2, 2)) * 2;
+			return Quaternion<T>((mat.elem(0, 2) - mat.elem(2, 0)) / s,
+				(mat.elem(0, 1) + mat.elem(1, 0)) / s,
+				s / 4,
+				(mat.elem(1, 2) + mat.elem(2, 1)) / s);
+		}
+		s = sqrt(1 + mat.elem(2, 2) - mat.elem(0, 0) - mat.elem(1, 1)) * 2;
+		return Quaternion<T>((mat.elem(1, 0) - mat.elem(0, 1)) / s,
+			(mat.elem(0, 2) + mat.elem(2, 0)) / s,
+			(mat.elem(1, 2) + mat.elem(2, 1)) / s,
+			s / 4);
+	}
+
+	template<typename T>
+	Quaternion<T> Quaternion<T>::fromMatrix(const Matrix<T, 3, 3, false>& mat)
+	{
+		return fromRotation(mat);
+	}
+
+	template<typename T>
+	Quaternion<T> Quaternion<T>::fromMatrix(const Matrix<T, 4, 4, false>& mat)
+	{
+		return fromRotation(mat);
+	}
+
+	template<typename T>
+	Vector<T, 3> Quaternion<T>::toEuler() const
+	{
+		T x = data[0], y = data[1], z = data[2], w = data[3];
+		T m12 = 2 * (y * z - w * x);
+		m12 = m12 > 1 ? 1 : m12 < -1 ? -1 : m12;
+		// at pitch = +-90 degrees yaw and roll turn about the same axis, all of it is put into yaw
+		if (m12 > (T)0.999999 || m12 < -(T)0.999999)
+			return Vector<T, 3>(atan2(2 * (x * z - w * y), 1 - 2 * (y * y + z * z)), asin(-m12), 0);
+		return Vector<T, 3>(
+			-atan2(2 * (x * z + w * y), 1 - 2 * (x * x + y * y)),
+			asin(-m12),
+			-atan2(2 * (x * y + w * z), 1 - 2 * (x * x + z * z)));
+	}
+
+	template<typename T>
+	Matrix<T, 3, 3, false> Quaternion<T>::toMat3() const
+	{
+		T x = data[0], y = data[1], z = data[2], w = data[3];
+		Matrix<T, 3, 3, false> res;
+		res.elem(0, 0) = 1 - 2 * (y * y + z * z);
+		res.elem(0, 1) = 2 * (x * y - w * z);
+		res.elem(0, 2) = 2 * (x * z + w * y);
+		res.elem(1, 0) = 2 * (x * y + w * z);
+		res.elem(1, 1) = 1 - 2 * (x * x + z * z);
+		res.elem(1, 2) = 2 * (y * z - w * x);
+		res.elem(2, 0) = 2 * (x * z - w * y);
+		res.elem(2, 1) = 2 * (y * z + w * x);
+		res.elem(2, 2) = 1 - 2 * (x * x + y * y);
+		return res;
+	}
+
+	template<typename T>
+	Matrix<T, 4, 4, false> Quaternion<T>::toMat4() const
+	{
+		Matrix<T, 3, 3, false> rot = toMat3();
+		Matrix<T, 4, 4, false> res;
+		for (size_t i = 0; i < 3; i++)
+			for (size_t j = 0; j < 3; j++)
+				res.elem(i, j) = rot.elem(i, j);
+		res.elem(3, 3) = 1;
+		return res;
+	}
+
+	template<typename T>
+	constexpr Quaternion<T> Quaternion<T>::operator*(const Quaternion<T>& rOpnt) const
+	{
+		const T* l = data;
+		const T* r = rOpnt.data;
+		return Quaternion<T>(
+			l[3] * r[3] - l[0] * r[0] - l[1] * r[1] - l[2] * r[2],
+			l[3] * r[0] + l[0] * r[3] + l[1] * r[2] - l[2] * r[1],
+			l[3] * r[1] - l[0] * r[2] + l[1] * r[3] + l[2] * r[0],
+			l[3] * r[2] + l[0] * r[1] - l[1] * r[0] + l[2] * r[3]);
+	}
+
+	template<typename T>
+	constexpr Quaternion<T>& Quaternion<T>::operator*=(const Quaternion<T>& rOpnt)
+	{
+		*this = (*this) * rOpnt;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr Vector<T, 3> Quaternion<T>::operator*(const Vector<T, 3>& rOpnt) const
+	{
+		// v + w * t + u x t with t = 2 * ( u x v ), no matrix is formed
+		Vector<T, 3> u = vec();
+		Vector<T, 3> t = Vector<T, 3>::cross(u, rOpnt);
+		t *= 2;
+		Vector<T, 3> res = Vector<T, 3>::cross(u, t);
+		res += rOpnt + data[3] * t;
+		return res;
+	}
+
+	template<typename T>
+	constexpr Quaternion<T> Quaternion<T>::operator+(const Quaternion<T>& rOpnt) const
+	{
+		return Quaternion<T>(data[3] + rOpnt.data[3], data[0] + rOpnt.data[0], data[1] + rOpnt.data[1], data[2] + rOpnt.data[2]);
+	}
+
+	template<typename T>
+	constexpr Quaternion<T> Quaternion<T>::operator-() const
+	{
+		return Quaternion<T>(-data[3], -data[0], -data[1], -data[2]);
+	}
+
+	template<typename T>
+	constexpr Quaternion<T> Quaternion<T>::operator*(T rOpnt) const
+	{
+		return Quaternion<T>(data[3] * rOpnt, data[0] * rOpnt, data[1] * rOpnt, data[2] * rOpnt);
+	}
+
+	template<typename T>
+	constexpr bool Quaternion<T>::operator==(const Quaternion<T>& rOpnt) const
+	{
+		for (size_t i = 0; i < 4; i++)
+			if (data[i] != rOpnt.data[i])
+				return false;
+		return true;
+	}
+
+	template<typename T>
+	constexpr bool Quaternion<T>::operator!=(const Quaternion<T>& rOpnt) const
+	{
+		return !((*this) == rOpnt);
+	}
+
+	template<typename T>
+	constexpr T Quaternion<T>::dot(const Quaternion<T>& lOpnt, const Quaternion<T>& rOpnt)
+	{
+		T res = 0;
+		for (size_t i = 0; i < 4; i++)
+			res += lOpnt.data[i] * rOpnt.data[i];
+		return res;
+	}
+
+	template<typename T>
+	T Quaternion<T>::norm() const
+	{
+		return sqrt(norm2());
+	}
+
+	template<typename T>
+	Quaternion<T> Quaternion<T>::normalize() const
+	{
+		T len = norm();
+		if (len == 0)
+		{
+			std::cerr << "ERROR | XGL::Quaternion::normalize() : Zero quaternion cannot be normalized.\n";
+			throw ZERO_QUATERNION;
+		}
+		return (*this) * (1 / len);
+	}
+
+	template<typename T>
+	Quaternion<T> Quaternion<T>::inverse() const
+	{
+		T len2 = norm2();
+		if (len2 == 0)
+		{
+			std::cerr << "ERROR | XGL::Quaternion::inverse() : Zero quaternion cannot be inverted.\n";
+			throw ZERO_QUATERNION;
+		}
+		return conjugate() * (1 / len2);
+	}
+
+	template<typename T>
+	Quaternion<T> Quaternion<T>::nlerp(const Quaternion<T>& from, const Quaternion<T>& to, T t)
+	{
+		// q and -q are the same rotation, flip to take the shorter way round
+		T sign = dot(from, to) < 0 ? -1 : 1;
+		return (from * (1 - t) + to * (sign * t)).normalize();
+	}
+
+	template<typename T>
+	Quaternion<T> Quaternion<T>::slerp(const Quaternion<T>& from, const Quaternion<T>& to, T t)
+	{
+		T cosTheta = dot(from, to);
+		T sign = 1;
+		if (cosTheta < 0)
+		{
+			cosTheta = -cosTheta;
+			sign = -1;
+		}
+		// nearly parallel, sin(theta) is too small to divide by and nlerp is indistinguishable
+		if (cosTheta > (T)0.9995)
+			return nlerp(from, to, t);
+		T theta = acos(cosTheta);
+		T sinTheta = sin(theta);
+		return from * (sin((1 - t) * theta) / sinTheta) + to * (sign * sin(t * theta) / sinTheta);
+	}
+
+	template<typename T>
+	std::ostream& operator<<(std::ostream& output, const Quaternion<T>& rOpnt)
+	{
+		output << "( " << rOpnt.data[3] << "; " << rOpnt.data[0] << ", " << rOpnt.data[1] << ", " << rOpnt.data[2] << " )";
+		return output;
+	}
+}
+
+#endif // !XGL_QUATERNION_INL
@@ -0,0 +1,77 @@
+#ifndef XGL_SIMD_H
+#define XGL_SIMD_H
+
+#include <cstddef>
+
+// define XGL_NO_SIMD to force the scalar templates everywhere
+#ifndef XGL_NO_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define XGL_SIMD_SSE
+	#endif
+	#if defined(XGL_SIMD_SSE) && defined(__AVX__)
+		#define XGL_SIMD_AVX
+	#endif
+#endif
+
+// true while a constexpr function is evaluated at compile time, where the kernels below cannot run
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+	#define XGL_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+	#define XGL_CONSTANT_EVALUATED() false
+#endif
+
+#if defined(XGL_SIMD_AVX)
+	#include <immintrin.h>
+#elif defined(XGL_SIMD_SSE)
+	#include <emmintrin.h>
+#endif
+
+namespace XGL
+{
+#ifdef XGL_SIMD_SSE
+	// float kernels on column-major 4x4 blocks and 4-lane vectors
+	class SIMD
+	{
+		public:
+			static void mat4Mul(const float* lOpnt, const float* rOpnt, float* res);
+			static void mat4MulVec4(const float* lOpnt, const float* rOpnt, float* res);
+			static void mat4Transpose(const float* Opnt, float* res);
+			// false when the matrix is singular, res is then left untouched
+			static bool mat4Inverse(const float* Opnt, float* res);
+			static bool mat4AffineInverse(const float* Opnt, float* res);
+			// res is a column-major 3x3 block
+			static bool mat4InverseTranspose3(const float* Opnt, float* res);
+
+			static void vec4Add(const float* lOpnt, const float* rOpnt, float* res);
+			static void vec4Sub(const float* lOpnt, const float* rOpnt, float* res);
+			static void vec4Mul(const float* lOpnt, const float* rOpnt, float* res);
+			static void vec4Div(const float* lOpnt, const float* rOpnt, float* res);
+			static void vec4Scale(const float* lOpnt, float rOpnt, float* res);
+			static bool vec4HasZero(const float* Opnt);
+
+			// element-wise loops over n floats, 8 lanes at a time with AVX
+			static void arrayAdd(const float* lOpnt, const float* rOpnt, float* res, size_t n);
+			static void arraySub(const float* lOpnt, const float* rOpnt, float* res, size_t n);
+			static void arrayMul(const float* lOpnt, const float* rOpnt, float* res, size_t n);
+			static void arrayDiv(const float* lOpnt, const float* rOpnt, float* res, size_t n);
+			static void arrayScale(const float* lOpnt, float rOpnt, float* res, size_t n);
+			// res += lOpnt * rOpnt
+			static void arrayScaleAdd(const float* lOpnt, float rOpnt, float* res, size_t n);
+			static void arrayMulAdd(const float* lOpnt, const float* rOpnt, float* res, size_t n);
+			static void arrayMulSub(const float* lOpnt, const float* rOpnt, float* res, size_t n);
+			static void arraySqrt(const float* Opnt, float* res, size_t n);
+			static float arrayMin(const float* Opnt, size_t n);
+			static float arrayMax(const float* Opnt, size_t n);
+
+		private:
+			static __m128 vec3Cross(__m128 lOpnt, __m128 rOpnt);
+			static __m128 mat2Mul(__m128 lOpnt, __m128 rOpnt);
+			static __m128 mat2AdjMul(__m128 lOpnt, __m128 rOpnt);
+			static __m128 mat2MulAdj(__m128 lOpnt, __m128 rOpnt);
+	};
+#endif
+}
+
+#include "SIMD.inl"
+
+#endif // !XGL_SIMD_H
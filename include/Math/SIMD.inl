@@ -0,0 +1,429 @@
+#ifndef XGL_SIMD_INL
+#define XGL_SIMD_INL
+
+#include "SIMD.h"
+
+namespace XGL
+{
+#ifdef XGL_SIMD_SSE
+	inline void SIMD::mat4Mul(const float* lOpnt, const float* rOpnt, float* res)
+	{
+		// column j of the result is the combination of lOpnt's columns weighted by column j of rOpnt
+#ifdef XGL_SIMD_AVX
+		__m256 col0 = _mm256_broadcast_ps((const __m128*)(lOpnt + 0));
+		__m256 col1 = _mm256_broadcast_ps((const __m128*)(lOpnt + 4));
+		__m256 col2 = _mm256_broadcast_ps((const __m128*)(lOpnt + 8));
+		__m256 col3 = _mm256_broadcast_ps((const __m128*)(lOpnt + 12));
+		for (size_t j = 0; j < 4; j += 2)
+		{
+			__m256 r = _mm256_loadu_ps(rOpnt + 4 * j);
+			__m256 sum = _mm256_mul_ps(col0, _mm256_shuffle_ps(r, r, _MM_SHUFFLE(0, 0, 0, 0)));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(col1, _mm256_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(col2, _mm256_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 2, 2))));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(col3, _mm256_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3))));
+			_mm256_storeu_ps(res + 4 * j, sum);
+		}
+#else
+		__m128 col0 = _mm_loadu_ps(lOpnt + 0);
+		__m128 col1 = _mm_loadu_ps(lOpnt + 4);
+		__m128 col2 = _mm_loadu_ps(lOpnt + 8);
+		__m128 col3 = _mm_loadu_ps(lOpnt + 12);
+		for (size_t j = 0; j < 4; j++)
+		{
+			__m128 r = _mm_loadu_ps(rOpnt + 4 * j);
+			__m128 sum = _mm_mul_ps(col0, _mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 0, 0, 0)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(col1, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+			sum = _mm_add_ps(sum, _mm_mul_ps(col2, _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 2, 2))));
+			sum = _mm_add_ps(sum, _mm_mul_ps(col3, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3))));
+			_mm_storeu_ps(res + 4 * j, sum);
+		}
+#endif
+	}
+
+	inline void SIMD::mat4MulVec4(const float* lOpnt, const float* rOpnt, float* res)
+	{
+		__m128 sum = _mm_mul_ps(_mm_loadu_ps(lOpnt + 0), _mm_set1_ps(rOpnt[0]));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(lOpnt + 4), _mm_set1_ps(rOpnt[1])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(lOpnt + 8), _mm_set1_ps(rOpnt[2])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(lOpnt + 12), _mm_set1_ps(rOpnt[3])));
+		_mm_storeu_ps(res, sum);
+	}
+
+	inline void SIMD::mat4Transpose(const float* Opnt, float* res)
+	{
+		__m128 col0 = _mm_loadu_ps(Opnt + 0);
+		__m128 col1 = _mm_loadu_ps(Opnt + 4);
+		__m128 col2 = _mm_loadu_ps(Opnt + 8);
+		__m128 col3 = _mm_loadu_ps(Opnt + 12);
+		_MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+		_mm_storeu_ps(res + 0, col0);
+		_mm_storeu_ps(res + 4, col1);
+		_mm_storeu_ps(res + 8, col2);
+		_mm_storeu_ps(res + 12, col3);
+	}
+
+	inline __m128 SIMD::vec3Cross(__m128 lOpnt, __m128 rOpnt)
+	{
+		__m128 lYzx = _mm_shuffle_ps(lOpnt, lOpnt, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 rYzx = _mm_shuffle_ps(rOpnt, rOpnt, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 res = _mm_sub_ps(_mm_mul_ps(lOpnt, rYzx), _mm_mul_ps(lYzx, rOpnt));
+		return _mm_shuffle_ps(res, res, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+	// 2x2 blocks packed row by row in one register, # is the adjugate
+	inline __m128 SIMD::mat2Mul(__m128 lOpnt, __m128 rOpnt)
+	{
+		return _mm_add_ps(_mm_mul_ps(lOpnt, _mm_shuffle_ps(rOpnt, rOpnt, _MM_SHUFFLE(3, 0, 3, 0))),
+			_mm_mul_ps(_mm_shuffle_ps(lOpnt, lOpnt, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(rOpnt, rOpnt, _MM_SHUFFLE(1, 2, 1, 2))));
+	}
+
+	// lOpnt# * rOpnt
+	inline __m128 SIMD::mat2AdjMul(__m128 lOpnt, __m128 rOpnt)
+	{
+		return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(lOpnt, lOpnt, _MM_SHUFFLE(0, 0, 3, 3)), rOpnt),
+			_mm_mul_ps(_mm_shuffle_ps(lOpnt, lOpnt, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(rOpnt, rOpnt, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	// lOpnt * rOpnt#
+	inline __m128 SIMD::mat2MulAdj(__m128 lOpnt, __m128 rOpnt)
+	{
+		return _mm_sub_ps(_mm_mul_ps(lOpnt, _mm_shuffle_ps(rOpnt, rOpnt, _MM_SHUFFLE(0, 3, 0, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(lOpnt, lOpnt, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(rOpnt, rOpnt, _MM_SHUFFLE(1, 2, 1, 2))));
+	}
+
+	inline bool SIMD::mat4Inverse(const float* Opnt, float* res)
+	{
+		// 2x2 block inversion. The kernel reads the columns as rows, which inverts the transpose,
+		// and the transposed inverse read back column by column is the inverse again.
+		__m128 row0 = _mm_loadu_ps(Opnt + 0);
+		__m128 row1 = _mm_loadu_ps(Opnt + 4);
+		__m128 row2 = _mm_loadu_ps(Opnt + 8);
+		__m128 row3 = _mm_loadu_ps(Opnt + 12);
+
+		__m128 A = _mm_movelh_ps(row0, row1);
+		__m128 B = _mm_movehl_ps(row1, row0);
+		__m128 C = _mm_movelh_ps(row2, row3);
+		__m128 D = _mm_movehl_ps(row3, row2);
+
+		// ( |A|, |B|, |C|, |D| )
+		__m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+		__m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+		__m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+		__m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+		__m128 DC = mat2AdjMul(D, C);
+		__m128 AB = mat2AdjMul(A, B);
+		__m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, DC));
+		__m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, AB));
+		__m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, AB));
+		__m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, DC));
+
+		// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+		__m128 tr = _mm_mul_ps(AB, _mm_shuffle_ps(DC, DC, _MM_SHUFFLE(3, 1, 2, 0)));
+		tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+		tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 1, 1, 1)));
+		tr = _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+		if (_mm_cvtss_f32(detM) == 0)
+			return false;
+
+		__m128 rDetM = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), detM);
+		X = _mm_mul_ps(X, rDetM);
+		Y = _mm_mul_ps(Y, rDetM);
+		Z = _mm_mul_ps(Z, rDetM);
+		W = _mm_mul_ps(W, rDetM);
+
+		// the adjugate of each block folds into the shuffles that reassemble the rows
+		_mm_storeu_ps(res + 0, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(res + 4, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+		_mm_storeu_ps(res + 8, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(res + 12, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+		return true;
+	}
+
+	inline bool SIMD::mat4AffineInverse(const float* Opnt, float* res)
+	{
+		// the rows of the inverse 3x3 block are the cross products of its columns over the determinant
+		__m128 col0 = _mm_loadu_ps(Opnt + 0);
+		__m128 col1 = _mm_loadu_ps(Opnt + 4);
+		__m128 col2 = _mm_loadu_ps(Opnt + 8);
+		__m128 shift = _mm_loadu_ps(Opnt + 12);
+
+		__m128 row0 = vec3Cross(col1, col2);
+		__m128 row1 = vec3Cross(col2, col0);
+		__m128 row2 = vec3Cross(col0, col1);
+		float lanes[4];
+		_mm_storeu_ps(lanes, _mm_mul_ps(col0, row0));
+		float det = lanes[0] + lanes[1] + lanes[2];
+		if (det == 0)
+			return false;
+
+		__m128 rDet = _mm_set1_ps(1 / det);
+		row0 = _mm_mul_ps(row0, rDet);
+		row1 = _mm_mul_ps(row1, rDet);
+		row2 = _mm_mul_ps(row2, rDet);
+		__m128 row3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		// -( A^-1 * t ), with the bottom right 1 put into the w lane
+		__m128 sum = _mm_mul_ps(row0, _mm_shuffle_ps(shift, shift, _MM_SHUFFLE(0, 0, 0, 0)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(row1, _mm_shuffle_ps(shift, shift, _MM_SHUFFLE(1, 1, 1, 1))));
+		sum = _mm_add_ps(sum, _mm_mul_ps(row2, _mm_shuffle_ps(shift, shift, _MM_SHUFFLE(2, 2, 2, 2))));
+		_mm_storeu_ps(res + 0, row0);
+		_mm_storeu_ps(res + 4, row1);
+		_mm_storeu_ps(res + 8, row2);
+		_mm_storeu_ps(res + 12, _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), sum));
+		return true;
+	}
+
+	inline bool SIMD::mat4InverseTranspose3(const float* Opnt, float* res)
+	{
+		// the columns of the inverse transpose are the cross products of the columns over the determinant
+		__m128 col0 = _mm_loadu_ps(Opnt + 0);
+		__m128 col1 = _mm_loadu_ps(Opnt + 4);
+		__m128 col2 = _mm_loadu_ps(Opnt + 8);
+
+		__m128 res0 = vec3Cross(col1, col2);
+		__m128 res1 = vec3Cross(col2, col0);
+		__m128 res2 = vec3Cross(col0, col1);
+		float lanes[4];
+		_mm_storeu_ps(lanes, _mm_mul_ps(col0, res0));
+		float det = lanes[0] + lanes[1] + lanes[2];
+		if (det == 0)
+			return false;
+
+		__m128 rDet = _mm_set1_ps(1 / det);
+		res2 = _mm_mul_ps(res2, rDet);
+		// each 4-wide store spills one lane into the next column, which the next store overwrites
+		_mm_storeu_ps(res + 0, _mm_mul_ps(res0, rDet));
+		_mm_storeu_ps(res + 3, _mm_mul_ps(res1, rDet));
+		_mm_storel_pi((__m64*)(res + 6), res2);
+		_mm_store_ss(res + 8, _mm_movehl_ps(res2, res2));
+		return true;
+	}
+
+	inline void SIMD::vec4Add(const float* lOpnt, const float* rOpnt, float* res)
+	{
+		_mm_storeu_ps(res, _mm_add_ps(_mm_loadu_ps(lOpnt), _mm_loadu_ps(rOpnt)));
+	}
+
+	inline void SIMD::vec4Sub(const float* lOpnt, const float* rOpnt, float* res)
+	{
+		_mm_storeu_ps(res, _mm_sub_ps(_mm_loadu_ps(lOpnt), _mm_loadu_ps(rOpnt)));
+	}
+
+	inline void SIMD::vec4Mul(const float* lOpnt, const float* rOpnt, float* res)
+	{
+		_mm_storeu_ps(res, _mm_mul_ps(_mm_loadu_ps(lOpnt), _mm_loadu_ps(rOpnt)));
+	}
+
+	inline void SIMD::vec4Div(const float* lOpnt, const float* rOpnt, float* res)
+	{
+		_mm_storeu_ps(res, _mm_div_ps(_mm_loadu_ps(lOpnt), _mm_loadu_ps(rOpnt)));
+	}
+
+	inline void SIMD::vec4Scale(const float* lOpnt, float rOpnt, float* res)
+	{
+		_mm_storeu_ps(res, _mm_mul_ps(_mm_loadu_ps(lOpnt), _mm_set1_ps(rOpnt)));
+	}
+
+	inline bool SIMD::vec4HasZero(const float* Opnt)
+	{
+		return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(Opnt), _mm_setzero_ps())) != 0;
+	}
+
+	inline void SIMD::arrayAdd(const float* lOpnt, const float* rOpnt, float* res, size_t n)
+	{
+		size_t i = 0;
+#ifdef XGL_SIMD_AVX
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(res + i, _mm256_add_ps(_mm256_loadu_ps(lOpnt + i), _mm256_loadu_ps(rOpnt + i)));
+#endif
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(res + i, _mm_add_ps(_mm_loadu_ps(lOpnt + i), _mm_loadu_ps(rOpnt + i)));
+		for (; i < n; i++)
+			res[i] = lOpnt[i] + rOpnt[i];
+	}
+
+	inline void SIMD::arraySub(const float* lOpnt, const float* rOpnt, float* res, size_t n)
+	{
+		size_t i = 0;
+#ifdef XGL_SIMD_AVX
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(res + i, _mm256_sub_ps(_mm256_loadu_ps(lOpnt + i), _mm256_loadu_ps(rOpnt + i)));
+#endif
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(res + i, _mm_sub_ps(_mm_loadu_ps(lOpnt + i), _mm_loadu_ps(rOpnt + i)));
+		for (; i < n; i++)
+			res[i] = lOpnt[i] - rOpnt[i];
+	}
+
+	inline void SIMD::arrayMul(const float* lOpnt, const float* rOpnt, float* res, size_t n)
+	{
+		size_t i = 0;
+#ifdef XGL_SIMD_AVX
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(res + i, _mm256_mul_ps(_mm256_loadu_ps(lOpnt + i), _mm256_loadu_ps(rOpnt + i)));
+#endif
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(res + i, _mm_mul_ps(_mm_loadu_ps(lOpnt + i), _mm_loadu_ps(rOpnt + i)));
+		for (; i < n; i++)
+			res[i] = lOpnt[i] * rOpnt[i];
+	}
+
+	inline void SIMD::arrayDiv(const float* lOpnt, const float* rOpnt, float* res, size_t n)
+	{
+		size_t i = 0;
+#ifdef XGL_SIMD_AVX
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(res + i, _mm256_div_ps(_mm256_loadu_ps(lOpnt + i), _mm256_loadu_ps(rOpnt + i)));
+#endif
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(res + i, _mm_div_ps(_mm_loadu_ps(lOpnt + i), _mm_loadu_ps(rOpnt + i)));
+		for (; i < n; i++)
+			res[i] = lOpnt[i] / rOpnt[i];
+	}
+
+	inline void SIMD::arrayScale(const float* lOpnt, float rOpnt, float* res, size_t n)
+	{
+		size_t i = 0;
+#ifdef XGL_SIMD_AVX
+		__m256 k8 = _mm256_set1_ps(rOpnt);
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(res + i, _mm256_mul_ps(_mm256_loadu_ps(lOpnt + i), k8));
+#endif
+		__m128 k4 = _mm_set1_ps(rOpnt);
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(res + i, _mm_mul_ps(_mm_loadu_ps(lOpnt + i), k4));
+		for (; i < n; i++)
+			res[i] = lOpnt[i] * rOpnt;
+	}
+
+	inline void SIMD::arrayScaleAdd(const float* lOpnt, float rOpnt, float* res, size_t n)
+	{
+		size_t i = 0;
+#ifdef XGL_SIMD_AVX
+		__m256 k8 = _mm256_set1_ps(rOpnt);
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(res + i, _mm256_add_ps(_mm256_loadu_ps(res + i), _mm256_mul_ps(_mm256_loadu_ps(lOpnt + i), k8)));
+#endif
+		__m128 k4 = _mm_set1_ps(rOpnt);
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(res + i, _mm_add_ps(_mm_loadu_ps(res + i), _mm_mul_ps(_mm_loadu_ps(lOpnt + i), k4)));
+		for (; i < n; i++)
+			res[i] = res[i] + lOpnt[i] * rOpnt;
+	}
+
+	inline void SIMD::arrayMulAdd(const float* lOpnt, const float* rOpnt, float* res, size_t n)
+	{
+		size_t i = 0;
+#ifdef XGL_SIMD_AVX
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(res + i, _mm256_add_ps(_mm256_loadu_ps(res + i), _mm256_mul_ps(_mm256_loadu_ps(lOpnt + i), _mm256_loadu_ps(rOpnt + i))));
+#endif
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(res + i, _mm_add_ps(_mm_loadu_ps(res + i), _mm_mul_ps(_mm_loadu_ps(lOpnt + i), _mm_loadu_ps(rOpnt + i))));
+		for (; i < n; i++)
+			res[i] = res[i] + lOpnt[i] * rOpnt[i];
+	}
+
+	inline void SIMD::arrayMulSub(const float* lOpnt, const float* rOpnt, float* res, size_t n)
+	{
+		size_t i = 0;
+#ifdef XGL_SIMD_AVX
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(res + i, _mm256_sub_ps(_mm256_loadu_ps(res + i), _mm256_mul_ps(_mm256_loadu_ps(lOpnt + i), _mm256_loadu_ps(rOpnt + i))));
+#endif
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(res + i, _mm_sub_ps(_mm_loadu_ps(res + i), _mm_mul_ps(_mm_loadu_ps(lOpnt + i), _mm_loadu_ps(rOpnt + i))));
+		for (; i < n; i++)
+			res[i] = res[i] - lOpnt[i] * rOpnt[i];
+	}
+
+	inline void SIMD::arraySqrt(const float* Opnt, float* res, size_t n)
+	{
+		size_t i = 0;
+#ifdef XGL_SIMD_AVX
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(res + i, _mm256_sqrt_ps(_mm256_loadu_ps(Opnt + i)));
+#endif
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(res + i, _mm_sqrt_ps(_mm_loadu_ps(Opnt + i)));
+		for (; i < n; i++)
+			_mm_store_ss(res + i, _mm_sqrt_ss(_mm_load_ss(Opnt + i)));
+	}
+
+	inline float SIMD::arrayMin(const float* Opnt, size_t n)
+	{
+		// n must be at least 1
+		float res = Opnt[0];
+		size_t i = 0;
+		if (n >= 4)
+		{
+			float lanes[4];
+#ifdef XGL_SIMD_AVX
+			if (n >= 8)
+			{
+				__m256 acc = _mm256_loadu_ps(Opnt);
+				for (i = 8; i + 8 <= n; i += 8)
+					acc = _mm256_min_ps(acc, _mm256_loadu_ps(Opnt + i));
+				_mm_storeu_ps(lanes, _mm_min_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1)));
+			}
+			else
+#endif
+			{
+				__m128 acc = _mm_loadu_ps(Opnt);
+				for (i = 4; i + 4 <= n; i += 4)
+					acc = _mm_min_ps(acc, _mm_loadu_ps(Opnt + i));
+				_mm_storeu_ps(lanes, acc);
+			}
+			for (size_t k = 0; k < 4; k++)
+				if (lanes[k] < res)
+					res = lanes[k];
+		}
+		for (; i < n; i++)
+			if (Opnt[i] < res)
+				res = Opnt[i];
+		return res;
+	}
+
+	inline float SIMD::arrayMax(const float* Opnt, size_t n)
+	{
+		// n must be at least 1
+		float res = Opnt[0];
+		size_t i = 0;
+		if (n >= 4)
+		{
+			float lanes[4];
+#ifdef XGL_SIMD_AVX
+			if (n >= 8)
+			{
+				__m256 acc = _mm256_loadu_ps(Opnt);
+				for (i = 8; i + 8 <= n; i += 8)
+					acc = _mm256_max_ps(acc, _mm256_loadu_ps(Opnt + i));
+				_mm_storeu_ps(lanes, _mm_max_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1)));
+			}
+			else
+#endif
+			{
+				__m128 acc = _mm_loadu_ps(Opnt);
+				for (i = 4; i + 4 <= n; i += 4)
+					acc = _mm_max_ps(acc, _mm_loadu_ps(Opnt + i));
+				_mm_storeu_ps(lanes, acc);
+			}
+			for (size_t k = 0; k < 4; k++)
+				if (lanes[k] > res)
+					res = lanes[k];
+		}
+		for (; i < n; i++)
+			if (Opnt[i] > res)
+				res = Opnt[i];
+		return res;
+	}
+#endif
+}
+
+#endif // !XGL_SIMD_INL
@@ -1,10 +1,25 @@
 #ifndef XGL_TOOL_H
 #define XGL_TOOL_H
 
+#include <cstddef>
+
+// bounds checking of the public element accessors, defaults to on in debug builds only
+#ifndef XGL_CHECKED_ACCESS
+	#ifdef NDEBUG
+		#define XGL_CHECKED_ACCESS 0
+	#else
+		#define XGL_CHECKED_ACCESS 1
+	#endif
+#endif
+
 namespace XGL
 {
 	const double PI = 3.14159265358979323846;
 
+	// alignment of inline element storage, 16 bytes when the block is a whole number of SSE registers
+	template <typename T>
+	constexpr size_t storageAlignment(size_t count) { return (sizeof(T) * count) % 16 == 0 ? 16 : alignof(T); }
+
 	template <typename T>
 	T degToRad(T deg) { return (T)(deg * PI / 180); }
 
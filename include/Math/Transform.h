@@ -3,6 +3,7 @@
 
 #include "Vector.h"
 #include "Matrix.h"
+#include "Quaternion.h"
 
 namespace XGL
 {
@@ -13,13 +14,13 @@ namespace XGL
 
 		public:
 			template<typename T>
-			static Matrix<T, 4, 4, false> scale(T k);
+			static constexpr Matrix<T, 4, 4, false> scale(T k);
 			template<typename T>
-			static Matrix<T, 4, 4, false>& scale(Matrix<T, 4, 4, false>& source, T k);
+			static constexpr Matrix<T, 4, 4, false>& scale(Matrix<T, 4, 4, false>& source, T k);
 			template<typename T>
-			static Matrix<T, 4, 4, false> scale(T kx, T ky, T kz);
+			static constexpr Matrix<T, 4, 4, false> scale(T kx, T ky, T kz);
 			template<typename T>
-			static Matrix<T, 4, 4, false>& scale(Matrix<T, 4, 4, false>& source, T kx, T ky, T kz);
+			static constexpr Matrix<T, 4, 4, false>& scale(Matrix<T, 4, 4, false>& source, T kx, T ky, T kz);
 
 			template<typename T>
 			static Matrix<T, 4, 4, false> rotate(T yaw, T pitch, T roll);
@@ -31,9 +32,15 @@ namespace XGL
 			static Matrix<T, 4, 4, false>& rotate(Matrix<T, 4, 4, false>& source, T angle, Vector<T, 3> axis);
 
 			template<typename T>
-			static Matrix<T, 4, 4, false> translate(Vector<T, 3> shift);
+			static constexpr Matrix<T, 4, 4, false> translate(Vector<T, 3> shift);
 			template<typename T>
-			static Matrix<T, 4, 4, false>& translate(Matrix<T, 4, 4, false>& source, Vector<T, 3> shift);
+			static constexpr Matrix<T, 4, 4, false>& translate(Matrix<T, 4, 4, false>& source, Vector<T, 3> shift);
+
+			// translate(scale(rotation, scaling), shift) written in one pass
+			template<typename T>
+			static Matrix<T, 4, 4, false> compose(Vector<T, 3> shift, const Quaternion<T>& rotation, Vector<T, 3> scaling);
+			template<typename T>
+			static Matrix<T, 4, 4, false>& compose(Matrix<T, 4, 4, false>& res, Vector<T, 3> shift, const Quaternion<T>& rotation, Vector<T, 3> scaling);
 	};
 }
 
@@ -6,43 +6,43 @@
 namespace XGL
 {
 	template<typename T>
-	Matrix<T, 4, 4, false> Transform::scale(T k)
+	constexpr Matrix<T, 4, 4, false> Transform::scale(T k)
 	{
 		Matrix<T, 4, 4, false> res;
-		res(0, 0) = res(1, 1) = res(2, 2) = k;
-		res(3, 3) = 1;
+		res.elem(0, 0) = res.elem(1, 1) = res.elem(2, 2) = k;
+		res.elem(3, 3) = 1;
 		return res;
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false>& Transform::scale(Matrix<T, 4, 4, false>& source, T k)
+	constexpr Matrix<T, 4, 4, false>& Transform::scale(Matrix<T, 4, 4, false>& source, T k)
 	{
 		for (size_t i = 0; i < 3; i++)
 			for (size_t j = 0; j < 4; j++)
-				source(i, j) *= k;
+				source.elem(i, j) *= k;
 		return source;
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false> Transform::scale(T kx, T ky, T kz)
+	constexpr Matrix<T, 4, 4, false> Transform::scale(T kx, T ky, T kz)
 	{
 		Matrix<T, 4, 4, false> res;
-		res(0, 0) = kx;
-		res(1, 1) = ky;
-		res(2, 2) = kz;
-		res(3, 3) = 1;
+		res.elem(0, 0) = kx;
+		res.elem(1, 1) = ky;
+		res.elem(2, 2) = kz;
+		res.elem(3, 3) = 1;
 		return res;
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false>& Transform::scale(Matrix<T, 4, 4, false>& source, T kx, T ky, T kz)
+	constexpr Matrix<T, 4, 4, false>& Transform::scale(Matrix<T, 4, 4, false>& source, T kx, T ky, T kz)
 	{
 		for (size_t i = 0; i < 4; i++)
-			source(0, i) *= kx;
+			source.elem(0, i) *= kx;
 		for (size_t i = 0; i < 4; i++)
-			source(1, i) *= ky;
+			source.elem(1, i) *= ky;
 		for (size_t i = 0; i < 4; i++)
-			source(2, i) *= kz;
+			source.elem(2, i) *= kz;
 		return source;
 	}
 
@@ -53,16 +53,16 @@ namespace XGL
 		T s1 = sin(-yaw), s2 = sin(pitch), s3 = sin(-roll);
 		T c1 = cos(-yaw), c2 = cos(pitch), c3 = cos(-roll);
 
-		res(0, 0) = c1 * c3 + s1 * s2 * s3;
-		res(0, 1) = c3 * s1 * s2 - c1 * s3;
-		res(0, 2) = c2 * s1;
-		res(1, 0) = c2 * s3;
-		res(1, 1) = c2 * c3;
-		res(1, 2) = -s2;
-		res(2, 0) = c1 * s2 * s3 - c3 * s1;
-		res(2, 1) = c1 * c3 * s2 + s1 * s3;
-		res(2, 2) = c1 * c2;
-		res(3, 3) = 1;
+		res.elem(0, 0) = c1 * c3 + s1 * s2 * s3;
+		res.elem(0, 1) = c3 * s1 * s2 - c1 * s3;
+		res.elem(0, 2) = c2 * s1;
+		res.elem(1, 0) = c2 * s3;
+		res.elem(1, 1) = c2 * c3;
+		res.elem(1, 2) = -s2;
+		res.elem(2, 0) = c1 * s2 * s3 - c3 * s1;
+		res.elem(2, 1) = c1 * c3 * s2 + s1 * s3;
+		res.elem(2, 2) = c1 * c2;
+		res.elem(3, 3) = 1;
 
 		return res;
 	}
@@ -81,16 +81,16 @@ namespace XGL
 		Matrix<T, 4, 4, false> res;
 		T s = sin(angle), c = cos(angle);
 
-		res(0, 0) = c + axis.x() * axis.x() * (1 - c);
-		res(0, 1) = axis.x() * axis.y() * (1 - c) - axis.z() * s;
-		res(0, 2) = axis.x() * axis.z() * (1 - c) + axis.y() * s;
-		res(1, 0) = axis.y() * axis.x() * (1 - c) + axis.z() * s;
-		res(1, 1) = c + axis.y() * axis.y() * (1 - c);
-		res(1, 2) = axis.y() * axis.z() * (1 - c) - axis.x() * s;
-		res(2, 0) = axis.z() * axis.x() * (1 - c) - axis.y() * s;
-		res(2, 1) = axis.z() * axis.y() * (1 - c) + axis.x() * s;
-		res(2, 2) = c + axis.z() * axis.z() * (1 - c);
-		res(3, 3) = 1;
+		res.elem(0, 0) = c + axis.x() * axis.x() * (1 - c);
+		res.elem(0, 1) = axis.x() * axis.y() * (1 - c) - axis.z() * s;
+		res.elem(0, 2) = axis.x() * axis.z() * (1 - c) + axis.y() * s;
+		res.elem(1, 0) = axis.y() * axis.x() * (1 - c) + axis.z() * s;
+		res.elem(1, 1) = c + axis.y() * axis.y() * (1 - c);
+		res.elem(1, 2) = axis.y() * axis.z() * (1 - c) - axis.x() * s;
+		res.elem(2, 0) = axis.z() * axis.x() * (1 - c) - axis.y() * s;
+		res.elem(2, 1) = axis.z() * axis.y() * (1 - c) + axis.x() * s;
+		res.elem(2, 2) = c + axis.z() * axis.z() * (1 - c);
+		res.elem(3, 3) = 1;
 
 		return res;
 	}
@@ -103,21 +103,57 @@ namespace XGL
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false> Transform::translate(Vector<T, 3> shift)
+	constexpr Matrix<T, 4, 4, false> Transform::translate(Vector<T, 3> shift)
 	{
 		Matrix<T, 4, 4, false> res = Matrix<T, 4, 4, false>::identity();
-		res(0, 3) = shift.x();
-		res(1, 3) = shift.y();
-		res(2, 3) = shift.z();
+		res.elem(0, 3) = shift.x();
+		res.elem(1, 3) = shift.y();
+		res.elem(2, 3) = shift.z();
 		return res;
 	}
 
 	template<typename T>
-	Matrix<T, 4, 4, false>& Transform::translate(Matrix<T, 4, 4, false>& source, Vector<T, 3> shift)
+	constexpr Matrix<T, 4, 4, false>& Transform::translate(Matrix<T, 4, 4, false>& source, Vector<T, 3> shift)
 	{
 		source = translate(shift) * source;
 		return source;
 	}
+
+	template<typename T>
+	Matrix<T, 4, 4, false> Transform::compose(Vector<T, 3> shift, const Quaternion<T>& rotation, Vector<T, 3> scaling)
+	{
+		Matrix<T, 4, 4, false> res;
+		return compose(res, shift, rotation, scaling);
+	}
+
+	template<typename T>
+	Matrix<T, 4, 4, false>& Transform::compose(Matrix<T, 4, 4, false>& res, Vector<T, 3> shift, const Quaternion<T>& rotation, Vector<T, 3> scaling)
+	{
+		// rotation rows scaled by kx, ky, kz, translation in the last column
+		T x = rotation.x(), y = rotation.y(), z = rotation.z(), w = rotation.w();
+		T xx = x * x, yy = y * y, zz = z * z;
+		T xy = x * y, xz = x * z, yz = y * z;
+		T wx = w * x, wy = w * y, wz = w * z;
+		T kx = scaling.x(), ky = scaling.y(), kz = scaling.z();
+
+		res.elem(0, 0) = (1 - 2 * (yy + zz)) * kx;
+		res.elem(0, 1) = 2 * (xy - wz) * kx;
+		res.elem(0, 2) = 2 * (xz + wy) * kx;
+		res.elem(0, 3) = shift.x();
+		res.elem(1, 0) = 2 * (xy + wz) * ky;
+		res.elem(1, 1) = (1 - 2 * (xx + zz)) * ky;
+		res.elem(1, 2) = 2 * (yz - wx) * ky;
+		res.elem(1, 3) = shift.y();
+		res.elem(2, 0) = 2 * (xz - wy) * kz;
+		res.elem(2, 1) = 2 * (yz + wx) * kz;
+		res.elem(2, 2) = (1 - 2 * (xx + yy)) * kz;
+		res.elem(2, 3) = shift.z();
+		res.elem(3, 0) = 0;
+		res.elem(3, 1) = 0;
+		res.elem(3, 2) = 0;
+		res.elem(3, 3) = 1;
+		return res;
+	}
 }
 
 #endif // !XGL_Transform_INL
@@ -1,6 +1,9 @@
 #ifndef XGL_VECTOR_H
 #define XGL_VECTOR_H
 
+#include "Tool.h"
+#include "SIMD.h"
+#include "Expression.h"
 #include <iostream>
 
 namespace XGL
@@ -9,68 +12,74 @@ namespace XGL
 	class Vector;
 
 	template<typename T, int size>
-	class IVector
+	class IVector;
+
+	template<typename T, int size>
+	struct ExprTraits<Vector<T, size>>
+	{
+		typedef T Elem;
+		typedef IVector<T, size> Base;
+		static const int count = size;
+		static const bool elementwise = true;
+	};
+
+	template<typename T, int size>
+	class IVector : public Expression<Vector<T, size>, Vector<T, size>>
 	{
 		public:
 			enum ERROR { INVALID_SIZE, OUT_OF_RANGE, DIVISION_BY_ZERO, ZERO_VECTOR };
 
+			static const bool mayThrow = false;
+			static const bool isScalar = false;
+
 		protected:
-			T* data;
+			alignas(storageAlignment<T>(size)) T data[size];
 
 		public:
-			IVector();
-			IVector(const IVector<T, size>& other);
-			IVector(IVector<T, size>&& other);
-			~IVector() { delete[] data; }
-
-			Vector<T, size>& operator=(const IVector<T, size>& rOpnt);
-			Vector<T, size>& operator=(IVector<T, size>&& rOpnt);
-
-			T& operator[](size_t idx) const;
-			T& operator()(size_t idx) const;
-
-			Vector<T, size> operator-() const;
-
-			Vector<T, size> operator+(const Vector<T, size>& rOpnt) const;
-			Vector<T, size>& operator+=(const Vector<T, size>& rOpnt);
-
-			Vector<T, size> operator-(const Vector<T, size>& rOpnt) const;
-			Vector<T, size>& operator-=(const Vector<T, size>& rOpnt);
-
-			Vector<T, size> operator*(const Vector<T, size>& rOpnt) const;
-			Vector<T, size>& operator*=(const Vector<T, size>& rOpnt);
-
-			Vector<T, size> operator/(const Vector<T, size>& rOpnt) const;
-			Vector<T, size>& operator/=(const Vector<T, size>& rOpnt);
-
-			Vector<T, size> operator+(T rOpnt) const;
-			template<typename T, int size>
-			friend Vector<T, size> operator+(T lOpnt, const Vector<T, size>& rOpnt);
-			Vector<T, size>& operator+=(T rOpnt);
-
-			Vector<T, size> operator-(T rOpnt) const;
-			template<typename T, int size>
-			friend Vector<T, size> operator-(T lOpnt, const Vector<T, size>& rOpnt);
-			Vector<T, size>& operator-=(T rOpnt);
-
-			Vector<T, size> operator*(T rOpnt) const;
-			template<typename T, int size>
-			friend Vector<T, size> operator*(T lOpnt, const Vector<T, size>& rOpnt);
-			Vector<T, size>& operator*=(T rOpnt);
-
-			Vector<T, size> operator/(T rOpnt) const;
-			template<typename T, int size>
-			friend Vector<T, size> operator/(T lOpnt, const Vector<T, size>& rOpnt);
-			Vector<T, size>& operator/=(T rOpnt);
-
-			bool operator==(const Vector<T, size>& rOpnt) const;
-			bool operator!=(const Vector<T, size>& rOpnt) const;
-
-			static T dot(const Vector<T, size>& lOpnt, const Vector<T, size>& rOpnt);
-			T dot(const Vector<T, size>& rOpnt) const;
-
-			static T norm2(const Vector<T, size>& Opnt);
-			T norm2() const;
+			constexpr IVector();
+			template<typename E>
+			constexpr IVector(const Expression<E, Vector<T, size>>& expr);
+
+			template<typename E>
+			constexpr Vector<T, size>& operator=(const Expression<E, Vector<T, size>>& rOpnt);
+
+			constexpr T& operator[](size_t idx);
+			constexpr const T& operator[](size_t idx) const;
+			constexpr T& operator()(size_t idx);
+			constexpr const T& operator()(size_t idx) const;
+
+			// unchecked access regardless of XGL_CHECKED_ACCESS
+			constexpr T& elem(size_t idx) { return data[idx]; }
+			constexpr const T& elem(size_t idx) const { return data[idx]; }
+
+			// expression evaluation
+			constexpr T coeff(size_t idx) const { return data[idx]; }
+#ifdef XGL_SIMD_SSE
+			__m128 packet(size_t idx) const { return _mm_loadu_ps(data + idx); }
+#endif
+
+			template<typename E>
+			constexpr Vector<T, size>& operator+=(const Expression<E, Vector<T, size>>& rOpnt);
+			template<typename E>
+			constexpr Vector<T, size>& operator-=(const Expression<E, Vector<T, size>>& rOpnt);
+			template<typename E>
+			constexpr Vector<T, size>& operator*=(const Expression<E, Vector<T, size>>& rOpnt);
+			template<typename E>
+			constexpr Vector<T, size>& operator/=(const Expression<E, Vector<T, size>>& rOpnt);
+
+			constexpr Vector<T, size>& operator+=(T rOpnt);
+			constexpr Vector<T, size>& operator-=(T rOpnt);
+			constexpr Vector<T, size>& operator*=(T rOpnt);
+			constexpr Vector<T, size>& operator/=(T rOpnt);
+
+			constexpr bool operator==(const Vector<T, size>& rOpnt) const;
+			constexpr bool operator!=(const Vector<T, size>& rOpnt) const;
+
+			static constexpr T dot(const Vector<T, size>& lOpnt, const Vector<T, size>& rOpnt);
+			constexpr T dot(const Vector<T, size>& rOpnt) const;
+
+			static constexpr T norm2(const Vector<T, size>& Opnt);
+			constexpr T norm2() const;
 
 			static T norm(const Vector<T, size>& Opnt);
 			T norm() const;
@@ -78,12 +87,13 @@ namespace XGL
 			static Vector<T, size> normalize(const Vector<T, size>& Opnt);
 			Vector<T, size> normalize() const;
 
-			Vector<T, size>& fill(T elem);
+			constexpr Vector<T, size>& fill(T elem);
 
-			T* getData() const { return data; }
+			constexpr T* getData() { return data; }
+			constexpr const T* getData() const { return data; }
 
-			template<typename T, int size>
-			friend std::ostream& operator<<(std::ostream& output, const Vector<T, size>& rOpnt);
+			template<typename U, int n>
+			friend std::ostream& operator<<(std::ostream& output, const Vector<U, n>& rOpnt);
 	};
 
 	template<typename T, int size>
@@ -91,6 +101,7 @@ namespace XGL
 	{
 		public:
 			using IVector<T, size>::IVector;
+			using IVector<T, size>::operator=;
 	};
 
 	template<typename T>
@@ -98,10 +109,13 @@ namespace XGL
 	{
 		public:
 			using IVector<T, 2>::IVector;
-			Vector(T x, T y) { this->data[0] = x; this->data[1] = y; }
+			using IVector<T, 2>::operator=;
+			constexpr Vector(T x, T y) { this->data[0] = x; this->data[1] = y; }
 
-			T& x() const { return this->data[0]; }
-			T& y() const { return this->data[1]; }
+			constexpr T& x() { return this->data[0]; }
+			constexpr const T& x() const { return this->data[0]; }
+			constexpr T& y() { return this->data[1]; }
+			constexpr const T& y() const { return this->data[1]; }
 	};
 
 	template<typename T>
@@ -109,16 +123,20 @@ namespace XGL
 	{
 		public:
 			using IVector<T, 3>::IVector;
-			Vector(T x, T y, T z) { this->data[0] = x; this->data[1] = y; this->data[2] = z; }
-			Vector(Vector<T, 2> xy, T z) { this->data[0] = xy[0]; this->data[1] = xy[1]; this->data[2] = z; }
-			Vector(T x, Vector<T, 2> yz) { this->data[0] = x; this->data[1] = yz[0]; this->data[2] = yz[1]; }
-
-			static Vector<T, 3> cross(const Vector<T, 3>& lOpnt, const Vector<T, 3>& rOpnt);
-			Vector<T, 3> cross(const Vector<T, 3>& rOpnt) const;
-
-			T& x() const { return this->data[0]; }
-			T& y() const { return this->data[1]; }
-			T& z() const { return this->data[2]; }
+			using IVector<T, 3>::operator=;
+			constexpr Vector(T x, T y, T z) { this->data[0] = x; this->data[1] = y; this->data[2] = z; }
+			constexpr Vector(Vector<T, 2> xy, T z) { this->data[0] = xy.elem(0); this->data[1] = xy.elem(1); this->data[2] = z; }
+			constexpr Vector(T x, Vector<T, 2> yz) { this->data[0] = x; this->data[1] = yz.elem(0); this->data[2] = yz.elem(1); }
+
+			static constexpr Vector<T, 3> cross(const Vector<T, 3>& lOpnt, const Vector<T, 3>& rOpnt);
+			constexpr Vector<T, 3> cross(const Vector<T, 3>& rOpnt) const;
+
+			constexpr T& x() { return this->data[0]; }
+			constexpr const T& x() const { return this->data[0]; }
+			constexpr T& y() { return this->data[1]; }
+			constexpr const T& y() const { return this->data[1]; }
+			constexpr T& z() { return this->data[2]; }
+			constexpr const T& z() const { return this->data[2]; }
 	};
 
 	template<typename T>
@@ -126,17 +144,22 @@ namespace XGL
 	{
 		public:
 			using IVector<T, 4>::IVector;
-			Vector(T x, T y, T z, T w) { this->data[0] = x; this->data[1] = y; this->data[2] = z; this->data[3] = w; }
-			Vector(Vector<T, 3> xyz, T w) { this->data[0] = xyz[0]; this->data[1] = xyz[1]; this->data[2] = xyz[2]; this->data[3] = w; }
-			Vector(T x, Vector<T, 3> yzw) { this->data[0] = x; this->data[1] = yzw[0]; this->data[2] = yzw[1]; this->data[3] = yzw[2]; }
-			Vector(Vector<T, 2> xy, T z, T w) { this->data[0] = xy[0]; this->data[1] = xy[1]; this->data[2] = z; this->data[3] = w; }
-			Vector(T x, Vector<T, 2> yz, T w) { this->data[0] = x; this->data[1] = yz[0]; this->data[2] = yz[1]; this->data[3] = w; }
-			Vector(T x, T y, Vector<T, 2> zw) { this->data[0] = x; this->data[1] = y; this->data[2] = zw.ta[0]; this->data[3] = zw[1]; }
-
-			T& x() const { return this->data[0]; }
-			T& y() const { return this->data[1]; }
-			T& z() const { return this->data[2]; }
-			T& w() const { return this->data[3]; }
+			using IVector<T, 4>::operator=;
+			constexpr Vector(T x, T y, T z, T w) { this->data[0] = x; this->data[1] = y; this->data[2] = z; this->data[3] = w; }
+			constexpr Vector(Vector<T, 3> xyz, T w) { this->data[0] = xyz.elem(0); this->data[1] = xyz.elem(1); this->data[2] = xyz.elem(2); this->data[3] = w; }
+			constexpr Vector(T x, Vector<T, 3> yzw) { this->data[0] = x; this->data[1] = yzw.elem(0); this->data[2] = yzw.elem(1); this->data[3] = yzw.elem(2); }
+			constexpr Vector(Vector<T, 2> xy, T z, T w) { this->data[0] = xy.elem(0); this->data[1] = xy.elem(1); this->data[2] = z; this->data[3] = w; }
+			constexpr Vector(T x, Vector<T, 2> yz, T w) { this->data[0] = x; this->data[1] = yz.elem(0); this->data[2] = yz.elem(1); this->data[3] = w; }
+			constexpr Vector(T x, T y, Vector<T, 2> zw) { this->data[0] = x; this->data[1] = y; this->data[2] = zw.elem(0); this->data[3] = zw.elem(1); }
+
+			constexpr T& x() { return this->data[0]; }
+			constexpr const T& x() const { return this->data[0]; }
+			constexpr T& y() { return this->data[1]; }
+			constexpr const T& y() const { return this->data[1]; }
+			constexpr T& z() { return this->data[2]; }
+			constexpr const T& z() const { return this->data[2]; }
+			constexpr T& w() { return this->data[3]; }
+			constexpr const T& w() const { return this->data[3]; }
 	};
 
 	using Vec2 = Vector<float, 2>;
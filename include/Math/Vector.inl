@@ -7,288 +7,137 @@
 namespace XGL
 {
 	template<typename T, int size>
-	IVector<T, size>::IVector()
+	constexpr IVector<T, size>::IVector() : data()
 	{
-		if (size <= 0)
-		{
-			std::cerr << "ERROR | XGL::IVector::IVector() : Invalid size.\n";
-			throw INVALID_SIZE;
-		}
-		data = new T[size];
-		memset(data, 0, size * sizeof(T));
-	}
-
-	template<typename T, int size>
-	IVector<T, size>::IVector(const IVector<T, size>& other)
-	{
-		data = new T[size];
-		memcpy(data, other.data, size * sizeof(T));
+		static_assert(size > 0, "XGL::IVector : Invalid size.");
 	}
 
 	template<typename T, int size>
-	IVector<T, size>::IVector(IVector<T, size>&& other)
+	constexpr T& IVector<T, size>::operator[](size_t idx)
 	{
-		data = other.data;
-		other.data = NULL;
-	}
-
-	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator=(const IVector<T, size>& rOpnt)
-	{
-		if (data != rOpnt.data)
+#if XGL_CHECKED_ACCESS
+		if (idx < 0 || idx >= size)
 		{
-			delete[] data;
-			data = new T[size];
-			memcpy(data, rOpnt.data, size * sizeof(T));
+			std::cerr << "ERROR | XGL::IVector::operator[](size_t) : Index out of bounds.\n";
+			throw OUT_OF_RANGE;
 		}
-		return *static_cast<Vector<T, size>*>(this);
-	}
-
-	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator=(IVector<T, size>&& rOpnt)
-	{
-		delete[] data;
-		data = rOpnt.data;
-		rOpnt.data = NULL;
-		return *static_cast<Vector<T, size>*>(this);
+#endif
+		return data[idx];
 	}
 
 	template<typename T, int size>
-	T& IVector<T, size>::operator[](size_t idx) const
+	constexpr const T& IVector<T, size>::operator[](size_t idx) const
 	{
+#if XGL_CHECKED_ACCESS
 		if (idx < 0 || idx >= size)
 		{
 			std::cerr << "ERROR | XGL::IVector::operator[](size_t) : Index out of bounds.\n";
 			throw OUT_OF_RANGE;
 		}
+#endif
 		return data[idx];
 	}
 
 	template<typename T, int size>
-	T& IVector<T, size>::operator()(size_t idx) const
+	constexpr T& IVector<T, size>::operator()(size_t idx)
 	{
+#if XGL_CHECKED_ACCESS
 		if (idx < 0 || idx >= size)
 		{
 			std::cerr << "ERROR | XGL::IVector::operator()(size_t) : Index out of bounds.\n";
 			throw OUT_OF_RANGE;
 		}
+#endif
 		return data[idx];
 	}
 
 	template<typename T, int size>
-	Vector<T, size> IVector<T, size>::operator-() const
-	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = -data[i];
-		return res;
-	}
-
-	template<typename T, int size>
-	Vector<T, size> IVector<T, size>::operator+(const Vector<T, size>& rOpnt) const
+	constexpr const T& IVector<T, size>::operator()(size_t idx) const
 	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = data[i] + rOpnt.data[i];
-		return res;
-	}
-
-	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator+=(const Vector<T, size>& rOpnt)
-	{
-		for (size_t i = 0; i < size; i++)
-			data[i] += rOpnt.data[i];
-		return *static_cast<Vector<T, size>*>(this);
-	}
-
-	template<typename T, int size>
-	Vector<T, size> IVector<T, size>::operator-(const Vector<T, size>& rOpnt) const
-	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = data[i] - rOpnt.data[i];
-		return res;
-	}
-
-	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator-=(const Vector<T, size>& rOpnt)
-	{
-		for (size_t i = 0; i < size; i++)
-			data[i] -= rOpnt.data[i];
-		return *static_cast<Vector<T, size>*>(this);
-	}
-
-	template<typename T, int size>
-	Vector<T, size> IVector<T, size>::operator*(const Vector<T, size>& rOpnt) const
-	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = data[i] * rOpnt.data[i];
-		return res;
-	}
-
-	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator*=(const Vector<T, size>& rOpnt)
-	{
-		for (size_t i = 0; i < size; i++)
-			data[i] *= rOpnt.data[i];
-		return *static_cast<Vector<T, size>*>(this);
-	}
-
-	template<typename T, int size>
-	Vector<T, size> IVector<T, size>::operator/(const Vector<T, size>& rOpnt) const
-	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-		{
-			if (rOpnt.data[i] == 0)
-			{
-				std::cerr << "ERROR | XGL::IVector::operator/(const Vector<T, size>&) : Division by zero.\n";
-				throw DIVISION_BY_ZERO;
-			}
-			res.data[i] = data[i] / rOpnt.data[i];
-		}
-		return res;
-	}
-
-	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator/=(const Vector<T, size>& rOpnt)
-	{
-		for (size_t i = 0; i < size; i++)
+#if XGL_CHECKED_ACCESS
+		if (idx < 0 || idx >= size)
 		{
-			if (rOpnt.data[i] == 0)
-			{
-				std::cerr << "ERROR | XGL::IVector::operator/=(const Vector<T, size>&) : Division by zero.\n";
-				throw DIVISION_BY_ZERO;
-			}
-			data[i] /= rOpnt.data[i];
+			std::cerr << "ERROR | XGL::IVector::operator()(size_t) : Index out of bounds.\n";
+			throw OUT_OF_RANGE;
 		}
-		return *static_cast<Vector<T, size>*>(this);
-	}
-
-	template<typename T, int size>
-	Vector<T, size> IVector<T, size>::operator+(T rOpnt) const
-	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = data[i] + rOpnt;
-		return res;
+#endif
+		return data[idx];
 	}
 
 	template<typename T, int size>
-	Vector<T, size> operator+(T lOpnt, const Vector<T, size>& rOpnt)
+	template<typename E>
+	constexpr IVector<T, size>::IVector(const Expression<E, Vector<T, size>>& expr) : data()
 	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = lOpnt + rOpnt.data[i];
-		return res;
+		exprAssign<E, T, size>(data, expr.self());
 	}
 
 	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator+=(T rOpnt)
+	template<typename E>
+	constexpr Vector<T, size>& IVector<T, size>::operator=(const Expression<E, Vector<T, size>>& rOpnt)
 	{
-		for (size_t i = 0; i < size; i++)
-			data[i] += rOpnt;
+		exprAssign<E, T, size>(data, rOpnt.self());
 		return *static_cast<Vector<T, size>*>(this);
 	}
 
 	template<typename T, int size>
-	Vector<T, size> IVector<T, size>::operator-(T rOpnt) const
+	template<typename E>
+	constexpr Vector<T, size>& IVector<T, size>::operator+=(const Expression<E, Vector<T, size>>& rOpnt)
 	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = data[i] - rOpnt;
-		return res;
-	}
-
-	template<typename T, int size>
-	Vector<T, size> operator-(T lOpnt, const Vector<T, size>& rOpnt)
-	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = lOpnt - rOpnt.data[i];
-		return res;
+		return *this = this->self() + rOpnt;
 	}
 
 	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator-=(T rOpnt)
+	template<typename E>
+	constexpr Vector<T, size>& IVector<T, size>::operator-=(const Expression<E, Vector<T, size>>& rOpnt)
 	{
-		for (size_t i = 0; i < size; i++)
-			data[i] -= rOpnt;
-		return *static_cast<Vector<T, size>*>(this);
+		return *this = this->self() - rOpnt;
 	}
 
 	template<typename T, int size>
-	Vector<T, size> IVector<T, size>::operator*(T rOpnt) const
+	template<typename E>
+	constexpr Vector<T, size>& IVector<T, size>::operator*=(const Expression<E, Vector<T, size>>& rOpnt)
 	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = data[i] * rOpnt;
-		return res;
+		return *this = this->self() * rOpnt;
 	}
 
 	template<typename T, int size>
-	Vector<T, size> operator*(T lOpnt, const Vector<T, size>& rOpnt)
+	template<typename E>
+	constexpr Vector<T, size>& IVector<T, size>::operator/=(const Expression<E, Vector<T, size>>& rOpnt)
 	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = lOpnt * rOpnt.data[i];
-		return res;
+		return *this = this->self() / rOpnt;
 	}
 
 	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator*=(T rOpnt)
+	constexpr Vector<T, size>& IVector<T, size>::operator+=(T rOpnt)
 	{
-		for (size_t i = 0; i < size; i++)
-			data[i] *= rOpnt;
-		return *static_cast<Vector<T, size>*>(this);
+		return *this = this->self() + rOpnt;
 	}
 
 	template<typename T, int size>
-	Vector<T, size> IVector<T, size>::operator/(T rOpnt) const
+	constexpr Vector<T, size>& IVector<T, size>::operator-=(T rOpnt)
 	{
-		if (rOpnt == 0)
-		{
-			std::cerr << "ERROR | XGL::IVector::operator/(T) : Division by zero.\n";
-			throw DIVISION_BY_ZERO;
-		}
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-			res.data[i] = data[i] / rOpnt;
-		return res;
+		return *this = this->self() - rOpnt;
 	}
 
 	template<typename T, int size>
-	Vector<T, size> operator/(T lOpnt, const Vector<T, size>& rOpnt)
+	constexpr Vector<T, size>& IVector<T, size>::operator*=(T rOpnt)
 	{
-		Vector<T, size> res;
-		for (size_t i = 0; i < size; i++)
-		{
-			if (rOpnt.data[i] == 0)
-			{
-				std::cerr << "ERROR | XGL::operator/(T, const Vector<T, size>&) : Division by zero.\n";
-				throw IVector<T, size>::DIVISION_BY_ZERO;
-			}
-			res.data[i] = lOpnt / rOpnt.data[i];
-		}
-		return res;
+		return *this = this->self() * rOpnt;
 	}
 
 	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::operator/=(T rOpnt)
+	constexpr Vector<T, size>& IVector<T, size>::operator/=(T rOpnt)
 	{
 		if (rOpnt == 0)
 		{
 			std::cerr << "ERROR | XGL::IVector::operator/=(T) : Division by zero.\n";
 			throw DIVISION_BY_ZERO;
 		}
-		for (size_t i = 0; i < size; i++)
-			data[i] /= rOpnt;
-		return *static_cast<Vector<T, size>*>(this);
+		return *this = this->self() / rOpnt;
 	}
 
 	template<typename T, int size>
-	bool IVector<T, size>::operator==(const Vector<T, size>& rOpnt) const
+	constexpr bool IVector<T, size>::operator==(const Vector<T, size>& rOpnt) const
 	{
 		for (size_t i = 0; i < size; i++)
 			if (data[i] != rOpnt.data[i])
@@ -297,13 +146,13 @@ namespace XGL
 	}
 
 	template<typename T, int size>
-	bool IVector<T, size>::operator!=(const Vector<T, size>& rOpnt) const
+	constexpr bool IVector<T, size>::operator!=(const Vector<T, size>& rOpnt) const
 	{
 		return !((*this) == rOpnt);
 	}
 
 	template<typename T, int size>
-	T IVector<T, size>::dot(const Vector<T, size>& lOpnt, const Vector<T, size>& rOpnt)
+	constexpr T IVector<T, size>::dot(const Vector<T, size>& lOpnt, const Vector<T, size>& rOpnt)
 	{
 		T res = 0;
 		for (size_t i = 0; i < size; i++)
@@ -312,7 +161,7 @@ namespace XGL
 	}
 
 	template<typename T, int size>
-	T IVector<T, size>::dot(const Vector<T, size>& rOpnt) const
+	constexpr T IVector<T, size>::dot(const Vector<T, size>& rOpnt) const
 	{
 		T res = 0;
 		for (size_t i = 0; i < size; i++)
@@ -321,13 +170,13 @@ namespace XGL
 	}
 
 	template<typename T, int size>
-	T IVector<T, size>::norm2(const Vector<T, size>& Opnt)
+	constexpr T IVector<T, size>::norm2(const Vector<T, size>& Opnt)
 	{
 		return dot(Opnt, Opnt);
 	}
 
 	template<typename T, int size>
-	T IVector<T, size>::norm2() const
+	constexpr T IVector<T, size>::norm2() const
 	{
 		return dot(*static_cast<const Vector<T, size>*>(this));
 	}
@@ -353,7 +202,7 @@ namespace XGL
 			std::cerr << "ERROR | XGL::IVector::normalize(const Vector<T, size>&) : Zero vector cannot be normalized.\n";
 			throw ZERO_VECTOR;
 		}
-		return static_cast<IVector<T, size>>(Opnt) / len;
+		return Opnt / len;
 	}
 
 	template<typename T, int size>
@@ -369,7 +218,7 @@ namespace XGL
 	}
 
 	template<typename T, int size>
-	Vector<T, size>& IVector<T, size>::fill(T elem)
+	constexpr Vector<T, size>& IVector<T, size>::fill(T elem)
 	{
 		for (size_t i = 0; i < size; i++)
 			data[i] = elem;
@@ -389,7 +238,7 @@ namespace XGL
 	// ------- vec3 -------
 
 	template<typename T>
-	Vector<T, 3> Vector<T, 3>::cross(const Vector<T, 3>& lOpnt, const Vector<T, 3>& rOpnt)
+	constexpr Vector<T, 3> Vector<T, 3>::cross(const Vector<T, 3>& lOpnt, const Vector<T, 3>& rOpnt)
 	{
 		Vector<T, 3> res;
 		res.data[0] = lOpnt.data[1] * rOpnt.data[2] - lOpnt.data[2] * rOpnt.data[1];
@@ -399,7 +248,7 @@ namespace XGL
 	}
 
 	template<typename T>
-	Vector<T, 3> Vector<T, 3>::cross(const Vector<T, 3>& rOpnt) const
+	constexpr Vector<T, 3> Vector<T, 3>::cross(const Vector<T, 3>& rOpnt) const
 	{
 		Vector<T, 3> res;
 		res.data[0] = this->data[1] * rOpnt.data[2] - this->data[2] * rOpnt.data[1];
@@ -0,0 +1,92 @@
+#ifndef XGL_VECTOR_ARRAY_H
+#define XGL_VECTOR_ARRAY_H
+
+#include "Tool.h"
+#include "SIMD.h"
+#include "Vector.h"
+#include <vector>
+#include <type_traits>
+
+namespace XGL
+{
+	// Structure-of-arrays storage of Vector<T, size>: component k of every vector is kept contiguously in lane k.
+	// Each lane starts on an alignment boundary, so the bulk operations below run at full SIMD width.
+	template<typename T, int size>
+	class VectorArray
+	{
+		public:
+			enum ERROR { OUT_OF_RANGE, SIZE_MISMATCH, INVALID_STRIDE, EMPTY_ARRAY };
+
+			static const size_t alignment = 32;
+
+		private:
+			T* data;
+			size_t length;
+			size_t capacity;	// elements per lane, a whole number of alignment blocks
+
+			static size_t roundCapacity(size_t length);
+			static T* allocate(size_t capacity);
+			static void deallocate(T* ptr);
+
+			static void laneAdd(const T* lOpnt, const T* rOpnt, T* res, size_t n);
+			static void laneSub(const T* lOpnt, const T* rOpnt, T* res, size_t n);
+			static void laneDiv(const T* lOpnt, const T* rOpnt, T* res, size_t n);
+			static void laneScale(const T* lOpnt, T rOpnt, T* res, size_t n);
+			static void laneMulAdd(const T* lOpnt, const T* rOpnt, T* res, size_t n);
+			static void laneMulSub(const T* lOpnt, const T* rOpnt, T* res, size_t n);
+			static void laneSqrt(const T* Opnt, T* res, size_t n);
+			static T laneMin(const T* Opnt, size_t n);
+			static T laneMax(const T* Opnt, size_t n);
+
+		public:
+			VectorArray();
+			VectorArray(size_t length);
+			VectorArray(const std::vector<Vector<T, size>>& vectors);
+			VectorArray(const VectorArray<T, size>& other);
+			VectorArray(VectorArray<T, size>&& other) noexcept;
+			~VectorArray() { deallocate(data); }
+
+			VectorArray<T, size>& operator=(const VectorArray<T, size>& rOpnt);
+			VectorArray<T, size>& operator=(VectorArray<T, size>&& rOpnt) noexcept;
+
+			size_t getLength() const { return length; }
+			void resize(size_t length);
+
+			T* lane(size_t idx);
+			const T* lane(size_t idx) const;
+
+			Vector<T, size> get(size_t idx) const;
+			void set(size_t idx, const Vector<T, size>& value);
+
+			// conversion from and to interleaved records stride bytes apart, 0 for tightly packed
+			void fromInterleaved(const T* src, size_t length, size_t stride = 0);
+			void toInterleaved(T* dst, size_t stride = 0) const;
+
+			VectorArray<T, size>& operator+=(const VectorArray<T, size>& rOpnt);
+			VectorArray<T, size>& operator-=(const VectorArray<T, size>& rOpnt);
+			VectorArray<T, size>& operator*=(T rOpnt);
+
+			// res may alias either operand, it is resized to the operands' length
+			static void add(const VectorArray<T, size>& lOpnt, const VectorArray<T, size>& rOpnt, VectorArray<T, size>& res);
+			static void sub(const VectorArray<T, size>& lOpnt, const VectorArray<T, size>& rOpnt, VectorArray<T, size>& res);
+			static void scale(const VectorArray<T, size>& lOpnt, T rOpnt, VectorArray<T, size>& res);
+			static void cross(const VectorArray<T, size>& lOpnt, const VectorArray<T, size>& rOpnt, VectorArray<T, size>& res);
+			// res holds getLength() scalars
+			static void dot(const VectorArray<T, size>& lOpnt, const VectorArray<T, size>& rOpnt, T* res);
+
+			// zero vectors are left as they are
+			VectorArray<T, size>& normalize();
+
+			// component-wise bounds of the whole array
+			Vector<T, size> min() const;
+			Vector<T, size> max() const;
+	};
+
+	using Vec2Array = VectorArray<float, 2>;
+	using Vec3Array = VectorArray<float, 3>;
+	using Vec4Array = VectorArray<float, 4>;
+}
+
+#include "VectorArray.inl"
+
+#endif // !XGL_VECTOR_ARRAY_H
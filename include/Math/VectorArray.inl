@@ -0,0 +1,475 @@
+#ifndef XGL_VECTOR_ARRAY_INL
+#define XGL_VECTOR_ARRAY_INL
+
+#include "VectorArray.h"
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <iostream>
+
+namespace XGL
+{
+	// --- storage ---
+
+	template<typename T, int size>
+	size_t VectorArray<T, size>::roundCapacity(size_t length)
+	{
+		size_t block = alignment / sizeof(T) ? alignment / sizeof(T) : 1;
+		return (length + block - 1) / block * block;
+	}
+
+	template<typename T, int size>
+	T* VectorArray<T, size>::allocate(size_t capacity)
+	{
+		if (capacity == 0)
+			return nullptr;
+		T* res = static_cast<T*>(::operator new[](sizeof(T) * size * capacity, std::align_val_t(alignment)));
+		memset(res, 0, sizeof(T) * size * capacity);
+		return res;
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::deallocate(T* ptr)
+	{
+		if (ptr)
+			::operator delete[](ptr, std::align_val_t(alignment));
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>::VectorArray() : data(nullptr), length(0), capacity(0)
+	{
+		static_assert(size > 0, "XGL::VectorArray : Invalid size.");
+		static_assert(std::is_trivially_copyable<T>::value, "XGL::VectorArray : Element type must be trivially copyable.");
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>::VectorArray(size_t length) : VectorArray()
+	{
+		resize(length);
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>::VectorArray(const std::vector<Vector<T, size>>& vectors) : VectorArray()
+	{
+		resize(vectors.size());
+		for (size_t i = 0; i < length; i++)
+			for (size_t k = 0; k < size; k++)
+				data[k * capacity + i] = vectors[i].elem(k);
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>::VectorArray(const VectorArray<T, size>& other) :
+		data(allocate(other.capacity)), length(other.length), capacity(other.capacity)
+	{
+		if (data)
+			memcpy(data, other.data, sizeof(T) * size * capacity);
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>::VectorArray(VectorArray<T, size>&& other) noexcept :
+		data(other.data), length(other.length), capacity(other.capacity)
+	{
+		other.data = nullptr;
+		other.length = other.capacity = 0;
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>& VectorArray<T, size>::operator=(const VectorArray<T, size>& rOpnt)
+	{
+		if (this == &rOpnt)
+			return *this;
+		if (capacity != rOpnt.capacity)
+		{
+			deallocate(data);
+			data = allocate(rOpnt.capacity);
+			capacity = rOpnt.capacity;
+		}
+		length = rOpnt.length;
+		if (data)
+			memcpy(data, rOpnt.data, sizeof(T) * size * capacity);
+		return *this;
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>& VectorArray<T, size>::operator=(VectorArray<T, size>&& rOpnt) noexcept
+	{
+		if (this == &rOpnt)
+			return *this;
+		deallocate(data);
+		data = rOpnt.data;
+		length = rOpnt.length;
+		capacity = rOpnt.capacity;
+		rOpnt.data = nullptr;
+		rOpnt.length = rOpnt.capacity = 0;
+		return *this;
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::resize(size_t length)
+	{
+		size_t newCapacity = roundCapacity(length);
+		if (newCapacity != capacity)
+		{
+			T* newData = allocate(newCapacity);
+			size_t kept = this->length < length ? this->length : length;
+			for (size_t k = 0; k < size && kept; k++)
+				memcpy(newData + k * newCapacity, data + k * capacity, sizeof(T) * kept);
+			deallocate(data);
+			data = newData;
+			capacity = newCapacity;
+		}
+		else if (length < this->length)
+		{
+			// the tail of each lane is kept zeroed for when the array grows again
+			for (size_t k = 0; k < size; k++)
+				memset(data + k * capacity + length, 0, sizeof(T) * (this->length - length));
+		}
+		this->length = length;
+	}
+
+	// --- access ---
+
+	template<typename T, int size>
+	T* VectorArray<T, size>::lane(size_t idx)
+	{
+#if XGL_CHECKED_ACCESS
+		if (idx >= size)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::lane(size_t) : Index out of bounds.\n";
+			throw OUT_OF_RANGE;
+		}
+#endif
+		return data + idx * capacity;
+	}
+
+	template<typename T, int size>
+	const T* VectorArray<T, size>::lane(size_t idx) const
+	{
+#if XGL_CHECKED_ACCESS
+		if (idx >= size)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::lane(size_t) : Index out of bounds.\n";
+			throw OUT_OF_RANGE;
+		}
+#endif
+		return data + idx * capacity;
+	}
+
+	template<typename T, int size>
+	Vector<T, size> VectorArray<T, size>::get(size_t idx) const
+	{
+#if XGL_CHECKED_ACCESS
+		if (idx >= length)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::get(size_t) : Index out of bounds.\n";
+			throw OUT_OF_RANGE;
+		}
+#endif
+		Vector<T, size> res;
+		for (size_t k = 0; k < size; k++)
+			res.elem(k) = data[k * capacity + idx];
+		return res;
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::set(size_t idx, const Vector<T, size>& value)
+	{
+#if XGL_CHECKED_ACCESS
+		if (idx >= length)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::set(size_t, const Vector<T, size>&) : Index out of bounds.\n";
+			throw OUT_OF_RANGE;
+		}
+#endif
+		for (size_t k = 0; k < size; k++)
+			data[k * capacity + idx] = value.elem(k);
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::fromInterleaved(const T* src, size_t length, size_t stride)
+	{
+		if (stride == 0)
+			stride = sizeof(T) * size;
+		else if (stride < sizeof(T) * size)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::fromInterleaved(const T*, size_t, size_t) : Stride is smaller than a record.\n";
+			throw INVALID_STRIDE;
+		}
+		resize(length);
+		const char* record = (const char*)src;
+		for (size_t i = 0; i < length; i++, record += stride)
+			for (size_t k = 0; k < size; k++)
+				data[k * capacity + i] = ((const T*)record)[k];
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::toInterleaved(T* dst, size_t stride) const
+	{
+		if (stride == 0)
+			stride = sizeof(T) * size;
+		else if (stride < sizeof(T) * size)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::toInterleaved(T*, size_t) : Stride is smaller than a record.\n";
+			throw INVALID_STRIDE;
+		}
+		char* record = (char*)dst;
+		for (size_t i = 0; i < length; i++, record += stride)
+			for (size_t k = 0; k < size; k++)
+				((T*)record)[k] = data[k * capacity + i];
+	}
+
+	// --- lane kernels ---
+
+	template<typename T, int size>
+	void VectorArray<T, size>::laneAdd(const T* lOpnt, const T* rOpnt, T* res, size_t n)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value)
+			return SIMD::arrayAdd(lOpnt, rOpnt, res, n);
+#endif
+		for (size_t i = 0; i < n; i++)
+			res[i] = lOpnt[i] + rOpnt[i];
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::laneSub(const T* lOpnt, const T* rOpnt, T* res, size_t n)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value)
+			return SIMD::arraySub(lOpnt, rOpnt, res, n);
+#endif
+		for (size_t i = 0; i < n; i++)
+			res[i] = lOpnt[i] - rOpnt[i];
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::laneDiv(const T* lOpnt, const T* rOpnt, T* res, size_t n)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value)
+			return SIMD::arrayDiv(lOpnt, rOpnt, res, n);
+#endif
+		for (size_t i = 0; i < n; i++)
+			res[i] = lOpnt[i] / rOpnt[i];
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::laneScale(const T* lOpnt, T rOpnt, T* res, size_t n)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value)
+			return SIMD::arrayScale(lOpnt, rOpnt, res, n);
+#endif
+		for (size_t i = 0; i < n; i++)
+			res[i] = lOpnt[i] * rOpnt;
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::laneMulAdd(const T* lOpnt, const T* rOpnt, T* res, size_t n)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value)
+			return SIMD::arrayMulAdd(lOpnt, rOpnt, res, n);
+#endif
+		for (size_t i = 0; i < n; i++)
+			res[i] = res[i] + lOpnt[i] * rOpnt[i];
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::laneMulSub(const T* lOpnt, const T* rOpnt, T* res, size_t n)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value)
+			return SIMD::arrayMulSub(lOpnt, rOpnt, res, n);
+#endif
+		for (size_t i = 0; i < n; i++)
+			res[i] = res[i] - lOpnt[i] * rOpnt[i];
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::laneSqrt(const T* Opnt, T* res, size_t n)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value)
+			return SIMD::arraySqrt(Opnt, res, n);
+#endif
+		for (size_t i = 0; i < n; i++)
+			res[i] = (T)std::sqrt(Opnt[i]);
+	}
+
+	template<typename T, int size>
+	T VectorArray<T, size>::laneMin(const T* Opnt, size_t n)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value)
+			return SIMD::arrayMin(Opnt, n);
+#endif
+		T res = Opnt[0];
+		for (size_t i = 1; i < n; i++)
+			if (Opnt[i] < res)
+				res = Opnt[i];
+		return res;
+	}
+
+	template<typename T, int size>
+	T VectorArray<T, size>::laneMax(const T* Opnt, size_t n)
+	{
+#ifdef XGL_SIMD_SSE
+		if constexpr (std::is_same<T, float>::value)
+			return SIMD::arrayMax(Opnt, n);
+#endif
+		T res = Opnt[0];
+		for (size_t i = 1; i < n; i++)
+			if (Opnt[i] > res)
+				res = Opnt[i];
+		return res;
+	}
+
+	// --- arithmetic ---
+
+	template<typename T, int size>
+	VectorArray<T, size>& VectorArray<T, size>::operator+=(const VectorArray<T, size>& rOpnt)
+	{
+		add(*this, rOpnt, *this);
+		return *this;
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>& VectorArray<T, size>::operator-=(const VectorArray<T, size>& rOpnt)
+	{
+		sub(*this, rOpnt, *this);
+		return *this;
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>& VectorArray<T, size>::operator*=(T rOpnt)
+	{
+		scale(*this, rOpnt, *this);
+		return *this;
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::add(const VectorArray<T, size>& lOpnt, const VectorArray<T, size>& rOpnt, VectorArray<T, size>& res)
+	{
+		if (lOpnt.length != rOpnt.length)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::add(const VectorArray<T, size>&, const VectorArray<T, size>&, VectorArray<T, size>&) : Size mismatch.\n";
+			throw SIZE_MISMATCH;
+		}
+		res.resize(lOpnt.length);
+		for (size_t k = 0; k < size; k++)
+			laneAdd(lOpnt.lane(k), rOpnt.lane(k), res.lane(k), res.length);
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::sub(const VectorArray<T, size>& lOpnt, const VectorArray<T, size>& rOpnt, VectorArray<T, size>& res)
+	{
+		if (lOpnt.length != rOpnt.length)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::sub(const VectorArray<T, size>&, const VectorArray<T, size>&, VectorArray<T, size>&) : Size mismatch.\n";
+			throw SIZE_MISMATCH;
+		}
+		res.resize(lOpnt.length);
+		for (size_t k = 0; k < size; k++)
+			laneSub(lOpnt.lane(k), rOpnt.lane(k), res.lane(k), res.length);
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::scale(const VectorArray<T, size>& lOpnt, T rOpnt, VectorArray<T, size>& res)
+	{
+		res.resize(lOpnt.length);
+		for (size_t k = 0; k < size; k++)
+			laneScale(lOpnt.lane(k), rOpnt, res.lane(k), res.length);
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::cross(const VectorArray<T, size>& lOpnt, const VectorArray<T, size>& rOpnt, VectorArray<T, size>& res)
+	{
+		static_assert(size == 3, "XGL::VectorArray::cross : Only defined for 3 components.");
+		if (lOpnt.length != rOpnt.length)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::cross(const VectorArray<T, size>&, const VectorArray<T, size>&, VectorArray<T, size>&) : Size mismatch.\n";
+			throw SIZE_MISMATCH;
+		}
+		// every output lane reads two input lanes, so an aliased result is built aside
+		if (&res == &lOpnt || &res == &rOpnt)
+		{
+			VectorArray<T, size> temp;
+			cross(lOpnt, rOpnt, temp);
+			res = std::move(temp);
+			return;
+		}
+		res.resize(lOpnt.length);
+		size_t n = res.length;
+		if (n == 0)
+			return;
+		for (size_t k = 0; k < 3; k++)
+		{
+			size_t a = (k + 1) % 3, b = (k + 2) % 3;
+			memset(res.lane(k), 0, sizeof(T) * n);
+			laneMulAdd(lOpnt.lane(a), rOpnt.lane(b), res.lane(k), n);
+			laneMulSub(lOpnt.lane(b), rOpnt.lane(a), res.lane(k), n);
+		}
+	}
+
+	template<typename T, int size>
+	void VectorArray<T, size>::dot(const VectorArray<T, size>& lOpnt, const VectorArray<T, size>& rOpnt, T* res)
+	{
+		if (lOpnt.length != rOpnt.length)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::dot(const VectorArray<T, size>&, const VectorArray<T, size>&, T*) : Size mismatch.\n";
+			throw SIZE_MISMATCH;
+		}
+		memset(res, 0, sizeof(T) * lOpnt.length);
+		for (size_t k = 0; k < size; k++)
+			laneMulAdd(lOpnt.lane(k), rOpnt.lane(k), res, lOpnt.length);
+	}
+
+	template<typename T, int size>
+	VectorArray<T, size>& VectorArray<T, size>::normalize()
+	{
+		if (length == 0)
+			return *this;
+		T* len = allocate(capacity);
+		for (size_t k = 0; k < size; k++)
+			laneMulAdd(lane(k), lane(k), len, length);
+		laneSqrt(len, len, length);
+		for (size_t i = 0; i < length; i++)
+			if (len[i] == 0)
+				len[i] = 1;
+		for (size_t k = 0; k < size; k++)
+			laneDiv(lane(k), len, lane(k), length);
+		deallocate(len);
+		return *this;
+	}
+
+	template<typename T, int size>
+	Vector<T, size> VectorArray<T, size>::min() const
+	{
+		if (length == 0)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::min() : Empty array.\n";
+			throw EMPTY_ARRAY;
+		}
+		Vector<T, size> res;
+		for (size_t k = 0; k < size; k++)
+			res.elem(k) = laneMin(lane(k), length);
+		return res;
+	}
+
+	template<typename T, int size>
+	Vector<T, size> VectorArray<T, size>::max() const
+	{
+		if (length == 0)
+		{
+			std::cerr << "ERROR | XGL::VectorArray::max() : Empty array.\n";
+			throw EMPTY_ARRAY;
+		}
+		Vector<T, size> res;
+		for (size_t k = 0; k < size; k++)
+			res.elem(k) = laneMax(lane(k), length);
+		return res;
+	}
+}
+
+#endif // !XGL_VECTOR_ARRAY_INL
@@ -3,6 +3,7 @@
 
 #include "Vector.h"
 #include "Matrix.h"
+#include "Quaternion.h"
 
 namespace XGL
 {
@@ -16,6 +17,8 @@ namespace XGL
 			static Matrix<T, 4, 4, false> lookAt(Vector<T, 3> pos, Vector<T, 3> target, Vector<T, 3> up);
 			template<typename T>
 			static Matrix<T, 4, 4, false> euler(Vector<T, 3> pos, T yaw, T pitch, T roll);
+			template<typename T>
+			static Matrix<T, 4, 4, false> orientation(Vector<T, 3> pos, const Quaternion<T>& rotation);
 	};
 }
 
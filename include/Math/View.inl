@@ -9,23 +9,23 @@ namespace XGL
 	Matrix<T, 4, 4, false> View::lookAt(Vector<T, 3> pos, Vector<T, 3> target, Vector<T, 3> up)
 	{
 		Matrix<T, 4, 4, false> res;
-		Vector<T, 3> z = (pos - target).normalize();
+		Vector<T, 3> z = (pos - target).eval().normalize();
 		Vector<T, 3> x = Vector<T, 3>::cross(up, z).normalize();
 		Vector<T, 3> y = Vector<T, 3>::cross(z, x);
 
-		res(0, 0) = x.x();
-		res(0, 1) = x.y();
-		res(0, 2) = x.z();
-		res(0, 3) = -Vector<T, 3>::dot(pos, x);
-		res(1, 0) = y.x();
-		res(1, 1) = y.y();
-		res(1, 2) = y.z();
-		res(1, 3) = -Vector<T, 3>::dot(pos, y);
-		res(2, 0) = z.x();
-		res(2, 1) = z.y();
-		res(2, 2) = z.z();
-		res(2, 3) = -Vector<T, 3>::dot(pos, z);
-		res(3, 3) = 1;
+		res.elem(0, 0) = x.x();
+		res.elem(0, 1) = x.y();
+		res.elem(0, 2) = x.z();
+		res.elem(0, 3) = -Vector<T, 3>::dot(pos, x);
+		res.elem(1, 0) = y.x();
+		res.elem(1, 1) = y.y();
+		res.elem(1, 2) = y.z();
+		res.elem(1, 3) = -Vector<T, 3>::dot(pos, y);
+		res.elem(2, 0) = z.x();
+		res.elem(2, 1) = z.y();
+		res.elem(2, 2) = z.z();
+		res.elem(2, 3) = -Vector<T, 3>::dot(pos, z);
+		res.elem(3, 3) = 1;
 
 		return res;
 	}
@@ -37,19 +37,35 @@ namespace XGL
 		T s1 = sin(-yaw), s2 = sin(pitch), s3 = sin(-roll);
 		T c1 = cos(-yaw), c2 = cos(pitch), c3 = cos(-roll);
 
-		res(0, 0) = c1 * c3 + s1 * s2 * s3;
-		res(0, 1) = c2 * s3;
-		res(0, 2) = c1 * s2 * s3 - c3 * s1;
-		res(0, 3) = res(0, 0) * -pos.x() + res(0, 1) * -pos.y() + res(0, 2) * -pos.z();
-		res(1, 0) = c3 * s1 * s2 - c1 * s3;
-		res(1, 1) = c2 * c3;
-		res(1, 2) = c1 * c3 * s2 + s1 * s3;
-		res(1, 3) = res(1, 0) * -pos.x() + res(1, 1) * -pos.y() + res(1, 2) * -pos.z();
-		res(2, 0) = c2 * s1;
-		res(2, 1) = -s2;
-		res(2, 2) = c1 * c2;
-		res(2, 3) = res(2, 0) * -pos.x() + res(2, 1) * -pos.y() + res(2, 2) * -pos.z();
-		res(3, 3) = 1;
+		res.elem(0, 0) = c1 * c3 + s1 * s2 * s3;
+		res.elem(0, 1) = c2 * s3;
+		res.elem(0, 2) = c1 * s2 * s3 - c3 * s1;
+		res.elem(0, 3) = res.elem(0, 0) * -pos.x() + res.elem(0, 1) * -pos.y() + res.elem(0, 2) * -pos.z();
+		res.elem(1, 0) = c3 * s1 * s2 - c1 * s3;
+		res.elem(1, 1) = c2 * c3;
+		res.elem(1, 2) = c1 * c3 * s2 + s1 * s3;
+		res.elem(1, 3) = res.elem(1, 0) * -pos.x() + res.elem(1, 1) * -pos.y() + res.elem(1, 2) * -pos.z();
+		res.elem(2, 0) = c2 * s1;
+		res.elem(2, 1) = -s2;
+		res.elem(2, 2) = c1 * c2;
+		res.elem(2, 3) = res.elem(2, 0) * -pos.x() + res.elem(2, 1) * -pos.y() + res.elem(2, 2) * -pos.z();
+		res.elem(3, 3) = 1;
+		return res;
+	}
+
+	template<typename T>
+	Matrix<T, 4, 4, false> View::orientation(Vector<T, 3> pos, const Quaternion<T>& rotation)
+	{
+		// the view undoes the camera's rotation, which for a unit quaternion is its conjugate
+		Matrix<T, 3, 3, false> rot = rotation.conjugate().toMat3();
+		Matrix<T, 4, 4, false> res;
+		for (size_t i = 0; i < 3; i++)
+		{
+			for (size_t j = 0; j < 3; j++)
+				res.elem(i, j) = rot.elem(i, j);
+			res.elem(i, 3) = res.elem(i, 0) * -pos.x() + res.elem(i, 1) * -pos.y() + res.elem(i, 2) * -pos.z();
+		}
+		res.elem(3, 3) = 1;
 		return res;
 	}
 }
@@ -0,0 +1,104 @@
+// Heap allocations made by camera updates and Vector/Matrix expressions, counted by replacing the
+// global operator new. Every section must report zero once the objects exist, the exit code is non-zero otherwise.
+#include <Math/Vector.h>
+#include <Math/Matrix.h>
+#include <Math/Quaternion.h>
+#include <Math/Tool.h>
+#include <Camera/Camera.h>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+
+using namespace std;
+
+using namespace XGL;
+
+size_t allocations = 0;
+size_t allocatedBytes = 0;
+
+void* operator new(size_t size)
+{
+	allocations++;
+	allocatedBytes += size;
+	if (void* p = malloc(size ? size : 1))
+		return p;
+	throw bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	free(p);
+}
+
+const int frames = 10000;
+
+volatile float sink;
+
+// sections that allocated
+int failures = 0;
+
+template<typename F>
+void track(const char* name, F body)
+{
+	size_t startCount = allocations;
+	size_t startBytes = allocatedBytes;
+	for (int i = 0; i < frames; i++)
+		body(i);
+	size_t n = allocations - startCount;
+	size_t bytes = allocatedBytes - startBytes;
+	cout << left << setw(28) << name << right << setw(10) << n << " allocs" << setw(12) << bytes << " bytes"
+		<< setw(10) << fixed << setprecision(2) << (double)n / frames << " per iteration" << (n ? "  FAIL" : "") << "\n";
+	if (n)
+		failures++;
+}
+
+int main()
+{
+	Camera camera;
+	camera.smoothMove(0.1);
+	camera.smoothRotate(0.1);
+	camera.smoothZoom(0.1);
+
+	Vec3 a(1, 2, 3), b(-1, 0.5, 2);
+	Vec4 p(1, 2, 3, 1);
+	Mat4 m = Mat4::identity();
+	Quat q = Quat::fromEuler(0.3, 0.2, 0.1);
+
+	cout << frames << " iterations each\n";
+
+	track("Camera::update, idle", [&](int) { camera.update(1.f / 60); });
+	track("Camera::move + update", [&](int i) { camera.move(Vec3(0.01f * (i % 3), 0, -0.01f)); camera.update(1.f / 60); });
+	track("Camera::rotate + update", [&](int) { camera.rotate(0.001f, 0.0005f); camera.update(1.f / 60); });
+	track("Camera::zoom + update", [&](int i) { camera.zoom(i % 2 ? 0.01f : -0.01f); camera.update(1.f / 60); });
+	track("Camera::moveForwardAl", [&](int) { camera.moveForwardAl(0.01f); camera.moveRightAl(0.01f); });
+	track("Vec3 a + b * s", [&](int i) { a = (a + b * (0.001f * i)).eval(); sink = a.x(); });
+	track("Vec3 cross/normalize", [&](int) { a = a.cross(b).normalize(); sink = a.y(); });
+	track("Mat4 * Mat4 * Vec4", [&](int) { p = m * m * p; sink = p.w(); });
+	track("Quat * Quat, toMat4", [&](int) { q = (q * q).normalize(); m = q.toMat4(); sink = m.elem(0, 0); });
+	track("Camera::viewMat * Vec4", [&](int) { p = camera.projectionMat() * camera.viewMat() * p; sink = p.x(); });
+
+	if (failures)
+		cout << failures << " sections allocated\n";
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+// BC1 and BC3 encoding throughput on one thread and on the thread pool, decoding throughput, and the PSNR
+// of the decoded image against the source.
+// usage: Bench_BlockCompression [image], a generated 2048x2048 gradient and noise image by default
+#include <BlockCompression/BlockCompression.h>
+#include <stb_image.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+
+using namespace XGL;
+
+const int rounds = 5;
+
+// smooth gradients with a noisy band, both kinds of blocks show up
+void buildImage(vector<unsigned char>& pixels, int width, int height)
+{
+	pixels.resize((size_t)width * height * 4);
+	unsigned int seed = 1;
+	for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+		{
+			unsigned char* p = &pixels[((size_t)y * width + x) * 4];
+			seed = seed * 1103515245 + 12345;
+			int noise = y > height / 2 && y < height * 3 / 4 ? (int)((seed >> 16) & 0x3f) - 32 : 0;
+			int r = (int)(128 + 127 * sin(x * 0.01)) + noise;
+			p[0] = (unsigned char)(r < 0 ? 0 : r > 255 ? 255 : r);
+			p[1] = (unsigned char)(y * 255 / height);
+			p[2] = (unsigned char)((x + y) * 255 / (width + height));
+			p[3] = (unsigned char)(x * 255 / width);
+		}
+}
+
+template<typename F>
+double measure(F body)
+{
+	auto start = chrono::high_resolution_clock::now();
+	for (int i = 0; i < rounds; i++)
+		body();
+	auto end = chrono::high_resolution_clock::now();
+	return chrono::duration<double, milli>(end - start).count() / rounds;
+}
+
+// only the channels the format keeps are compared, BC1 drops alpha
+double channelPsnr(const vector<unsigned char>& source, const vector<unsigned char>& decoded, int channelBegin, int channelEnd)
+{
+	vector<unsigned char> lOpnt, rOpnt;
+	for (size_t i = 0; i < source.size(); i += 4)
+		for (int c = channelBegin; c < channelEnd; c++)
+		{
+			lOpnt.push_back(source[i + c]);
+			rOpnt.push_back(decoded[i + c]);
+		}
+	return BlockCompression::psnr(lOpnt.data(), rOpnt.data(), lOpnt.size());
+}
+
+int main(int argc, char** argv)
+{
+	int width = 2048, height = 2048;
+	vector<unsigned char> pixels;
+	if (argc > 1)
+	{
+		int channel;
+		unsigned char* data = stbi_load(argv[1], &width, &height, &channel, 4);
+		if (!data)
+		{
+			cout << "Failed to load \"" << argv[1] << "\"" << endl;
+			return -1;
+		}
+		pixels.assign(data, data + (size_t)width * height * 4);
+		stbi_image_free(data);
+	}
+	else
+		buildImage(pixels, width, height);
+
+	double megapixels = (double)width * height / 1e6;
+	cout << width << "x" << height << " RGBA, " << rounds << " rounds\n";
+	cout << left << setw(8) << "format" << right << setw(16) << "encode" << setw(16) << "parallel" << setw(16) << "decode"
+		<< setw(12) << "RGB PSNR" << setw(12) << "A PSNR" << "\n";
+
+	BlockCompression::Format formats[] = { BlockCompression::BC1, BlockCompression::BC3 };
+	for (BlockCompression::Format format : formats)
+	{
+		vector<unsigned char> blocks(BlockCompression::getSize(format, width, height));
+		vector<unsigned char> parallelBlocks(blocks.size());
+		vector<unsigned char> decoded((size_t)width * height * 4);
+
+		double encode = measure([&]() { BlockCompression::encode(format, pixels.data(), width, height, 4, blocks.data()); });
+		double parallel = measure([&]() { BlockCompression::encodeParallel(format, pixels.data(), width, height, 4, parallelBlocks.data()); });
+		double decode = measure([&]() { BlockCompression::decode(format, blocks.data(), width, height, decoded.data()); });
+		if (blocks != parallelBlocks)
+			cout << "WARNING | encodeParallel() output differs from encode()\n";
+
+		cout << left << setw(8) << (format == BlockCompression::BC1 ? "BC1" : "BC3") << right << fixed << setprecision(1)
+			<< setw(10) << megapixels / encode * 1000 << " MP/s"
+			<< setw(10) << megapixels / parallel * 1000 << " MP/s"
+			<< setw(10) << megapixels / decode * 1000 << " MP/s"
+			<< setprecision(2) << setw(9) << channelPsnr(pixels, decoded, 0, 3) << " dB";
+		if (format == BlockCompression::BC3)
+			cout << setw(9) << channelPsnr(pixels, decoded, 3, 4) << " dB";
+		cout << "\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,192 @@
+// A scene of a few thousand objects mixing programs, texture sets and translucency, drawn in submission
+// order and then through RenderQueue. Prints the queue statistics and the binds GLState issued and elided.
+// Run from bin/ like the Test target, the shaders and images are the ones of src/Test and data/.
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <Math/Vector.h>
+#include <Math/Tool.h>
+#include <Camera/Camera.h>
+#include <Texture/Texture.h>
+#include <Program/Program.h>
+#include <Object/Object.h>
+#include <RenderQueue/RenderQueue.h>
+#include <GLState/GLState.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+
+using namespace XGL;
+
+const int objectCount = 4000;
+const int programCount = 3;
+const int textureCount = 4;
+const int frames = 100;
+
+void buildCube(Object& object, float size)
+{
+	for (int face = 0; face < 6; face++)
+	{
+		int axis = face / 2;
+		float side = face % 2 ? -size : size;
+		for (int corner = 0; corner < 4; corner++)
+		{
+			float u = corner == 1 || corner == 2 ? size : -size;
+			float v = corner >= 2 ? size : -size;
+			Vec3 p;
+			p.elem(axis) = side;
+			p.elem((axis + 1) % 3) = u;
+			p.elem((axis + 2) % 3) = v;
+			object.addModelPosition(p);
+			object.addModelTexcoord(Vec2(u > 0 ? 1 : 0, v > 0 ? 1 : 0));
+		}
+		unsigned int base = face * 4;
+		unsigned int quad[] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+		for (unsigned int index : quad)
+			object.addModelIndex(index);
+	}
+}
+
+template<typename F>
+double measure(F frame)
+{
+	GLState::resetCounters();
+	auto start = chrono::high_resolution_clock::now();
+	for (int i = 0; i < frames; i++)
+	{
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		frame();
+		glFinish();
+	}
+	auto end = chrono::high_resolution_clock::now();
+	return chrono::duration<double, milli>(end - start).count() / frames;
+}
+
+void report(const char* name, double ms)
+{
+	cout << left << setw(20) << name << right << fixed << setprecision(3) << setw(10) << ms << " ms/frame"
+		<< setw(12) << GLState::getIssuedCount() / frames << " issued" << setw(12) << GLState::getElidedCount() / frames << " elided\n";
+}
+
+int main()
+{
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	GLFWwindow* window = glfwCreateWindow(1280, 720, "RenderQueue", NULL, NULL);
+	if (window == NULL)
+	{
+		cout << "Failed to create GLFW window" << endl;
+		glfwTerminate();
+		return -1;
+	}
+	glfwMakeContextCurrent(window);
+	glfwSwapInterval(0);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		cout << "Failed to initialize GLAD" << endl;
+		return -1;
+	}
+
+	glViewport(0, 0, 1280, 720);
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	Camera camera;
+	camera.setPosition(Vec3(0, 0, 30));
+	camera.setLen(degToRad(60.f), 16.f / 9, 0.1, 200);
+	camera.update(1);
+
+	// programs built from the same sources are still distinct states to the queue
+	Shader<ShaderType::VERTEX> vertexShader("../src/Test/shaders/shader.vert");
+	Shader<ShaderType::FRAGMENT> fragmentShader("../src/Test/shaders/shader.frag");
+	vertexShader.compile();
+	fragmentShader.compile();
+	vector<Program*> programs;
+	for (int i = 0; i < programCount; i++)
+	{
+		Program* program = new Program();
+		program->setCamera(camera);
+		program->attachShader(vertexShader);
+		program->attachShader(fragmentShader);
+		program->link();
+		programs.push_back(program);
+	}
+
+	// every Texture is its own GL texture, loading an image twice still makes two texture states
+	const char* images[] = { "../data/container.jpg", "../data/awesomeface.png" };
+	vector<Texture*> textures;
+	for (int i = 0; i < textureCount; i++)
+	{
+		Texture* texture = new Texture(images[i % 2]);
+		texture->generate();
+		textures.push_back(texture);
+	}
+
+	// objects are created in an order unrelated to their state, as a scene graph would yield them
+	vector<Object*> objects;
+	vector<Program*> objectPrograms;
+	vector<RenderQueue::Pass> objectPasses;
+	unsigned int seed = 12345;
+	auto next = [&seed]() { seed = seed * 1103515245 + 12345; return (seed >> 16) & 0x7fff; };
+	for (int i = 0; i < objectCount; i++)
+	{
+		Object* object = new Object();
+		buildCube(*object, 0.2f + 0.1f * (next() % 4));
+		object->addTexture(*textures[next() % textureCount], "texture0", 0);
+		object->addTexture(*textures[next() % textureCount], "texture1", 1);
+		object->setPosition(Vec3((float)(next() % 400) / 10 - 20, (float)(next() % 240) / 10 - 12, -(float)(next() % 600) / 10));
+		object->setRotation((float)(next() % 628) / 100, Vec3(0.3, 1, 0.2));
+		objects.push_back(object);
+		objectPrograms.push_back(programs[next() % programCount]);
+		objectPasses.push_back(next() % 8 ? RenderQueue::SOLID : RenderQueue::TRANSLUCENT);
+	}
+
+	// first draw of each object builds its buffer, keep it out of the timings
+	for (int i = 0; i < objectCount; i++)
+		objectPrograms[i]->draw(*objects[i]);
+	glFinish();
+
+	cout << objectCount << " objects, " << programCount << " programs, " << textureCount << " textures, "
+		<< frames << " frames, " << (GLState::hasDSA() ? "DSA" : "no DSA") << "\n";
+
+	double ms = measure([&]()
+	{
+		for (int i = 0; i < objectCount; i++)
+			objectPrograms[i]->draw(*objects[i]);
+	});
+	report("submission order", ms);
+
+	RenderQueue queue;
+	ms = measure([&]()
+	{
+		for (int i = 0; i < objectCount; i++)
+			queue.submit(*objectPrograms[i], *objects[i], objectPasses[i]);
+		queue.flush();
+	});
+	report("RenderQueue", ms);
+
+	const RenderQueue::Statistics& statistics = queue.getStatistics();
+	cout << "last flush: " << statistics.items << " items, "
+		<< statistics.programChanges << " program changes, "
+		<< statistics.textureChanges << " texture changes, "
+		<< statistics.vertexArrayChanges << " vertex array changes, "
+		<< statistics.savedChanges << " changes saved\n";
+
+	for (Object* object : objects)
+		delete object;
+	for (Texture* texture : textures)
+		delete texture;
+	for (Program* program : programs)
+		delete program;
+
+	glfwTerminate();
+	return 0;
+}
@@ -0,0 +1,118 @@
+// Mat4/Vec4 arithmetic through the SIMD kernels against the scalar loops of the templates.
+// The scalar side repeats the element loops the templates fall back to with XGL_NO_SIMD.
+#include <Math/Matrix.h>
+#include <Math/Vector.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+
+using namespace XGL;
+
+const size_t batchSize = 1024;
+const int rounds = 2000;
+
+// keeps the results observable so the loops are not optimized away
+volatile float sink;
+
+void scalarMul(const Mat4& l, const Mat4& r, Mat4& res)
+{
+	for (size_t i = 0; i < 4; i++)
+		for (size_t j = 0; j < 4; j++)
+		{
+			float sum = 0;
+			for (size_t k = 0; k < 4; k++)
+				sum += l(i, k) * r(k, j);
+			res(i, j) = sum;
+		}
+}
+
+void scalarMulVec(const Mat4& l, const Vec4& r, Vec4& res)
+{
+	for (size_t i = 0; i < 4; i++)
+	{
+		float sum = 0;
+		for (size_t k = 0; k < 4; k++)
+			sum += l(i, k) * r[k];
+		res[i] = sum;
+	}
+}
+
+void scalarTranspose(const Mat4& m, Mat4& res)
+{
+	for (size_t i = 0; i < 4; i++)
+		for (size_t j = 0; j < 4; j++)
+			res(j, i) = m(i, j);
+}
+
+void scalarMulAdd(const Vec4& a, const Vec4& b, float s, Vec4& res)
+{
+	for (size_t i = 0; i < 4; i++)
+		res[i] = a[i] + b[i] * s;
+}
+
+template<typename F>
+double measure(F body)
+{
+	auto start = chrono::high_resolution_clock::now();
+	for (int r = 0; r < rounds; r++)
+		body();
+	auto end = chrono::high_resolution_clock::now();
+	return chrono::duration<double, nano>(end - start).count() / ((double)rounds * batchSize);
+}
+
+void report(const char* name, double simd, double scalar)
+{
+	cout << left << setw(16) << name << right << fixed << setprecision(2)
+		<< setw(10) << simd << " ns" << setw(10) << scalar << " ns" << setw(8) << scalar / simd << "x\n";
+}
+
+int main()
+{
+	vector<Mat4> matrices(batchSize), results(batchSize);
+	vector<Vec4> vectors(batchSize), vectorResults(batchSize);
+	for (size_t n = 0; n < batchSize; n++)
+	{
+		for (size_t i = 0; i < 4; i++)
+		{
+			for (size_t j = 0; j < 4; j++)
+				matrices[n](i, j) = (float)((n + 3 * i + 7 * j) % 13) / 13 - 0.5f;
+			vectors[n][i] = (float)((n + 5 * i) % 11) / 11;
+		}
+	}
+
+#ifdef XGL_SIMD_AVX
+	cout << "kernels: AVX\n";
+#elif defined(XGL_SIMD_SSE)
+	cout << "kernels: SSE\n";
+#else
+	cout << "kernels: none, both columns run the scalar loops\n";
+#endif
+	cout << left << setw(16) << "op" << right << setw(13) << "template" << setw(13) << "scalar" << setw(9) << "ratio" << "\n";
+
+	double simd, scalar;
+
+	simd = measure([&]() { for (size_t n = 0; n < batchSize; n++) results[n] = matrices[n] * matrices[batchSize - 1 - n]; });
+	scalar = measure([&]() { for (size_t n = 0; n < batchSize; n++) scalarMul(matrices[n], matrices[batchSize - 1 - n], results[n]); });
+	sink = results[batchSize / 2](1, 2);
+	report("Mat4 * Mat4", simd, scalar);
+
+	simd = measure([&]() { for (size_t n = 0; n < batchSize; n++) vectorResults[n] = matrices[n] * vectors[n]; });
+	scalar = measure([&]() { for (size_t n = 0; n < batchSize; n++) scalarMulVec(matrices[n], vectors[n], vectorResults[n]); });
+	sink = vectorResults[batchSize / 2][3];
+	report("Mat4 * Vec4", simd, scalar);
+
+	simd = measure([&]() { for (size_t n = 0; n < batchSize; n++) results[n] = matrices[n].transpose(); });
+	scalar = measure([&]() { for (size_t n = 0; n < batchSize; n++) scalarTranspose(matrices[n], results[n]); });
+	sink = results[batchSize / 2](0, 3);
+	report("transpose", simd, scalar);
+
+	simd = measure([&]() { for (size_t n = 0; n < batchSize; n++) vectorResults[n] = vectors[n] + vectors[batchSize - 1 - n] * 0.5f; });
+	scalar = measure([&]() { for (size_t n = 0; n < batchSize; n++) scalarMulAdd(vectors[n], vectors[batchSize - 1 - n], 0.5f, vectorResults[n]); });
+	sink = vectorResults[batchSize / 2][0];
+	report("Vec4 a + b * s", simd, scalar);
+
+	return 0;
+}
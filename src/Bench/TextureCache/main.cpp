@@ -0,0 +1,110 @@
+// Startup cost of loading a directory of images: straight from the sources, through TextureCache with an
+// empty cache, then again with the cache filled by the previous pass.
+// usage: Bench_TextureCache [image directory = ../data] [cache directory = bench_texture_cache]
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <Texture/Texture.h>
+#include <TextureCache/TextureCache.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+using namespace XGL;
+
+bool isImage(const filesystem::path& path)
+{
+	string extension = path.extension().string();
+	transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+	return extension == ".jpg" || extension == ".jpeg" || extension == ".png" || extension == ".bmp"
+		|| extension == ".tga" || extension == ".psd" || extension == ".hdr";
+}
+
+// every texture of a pass is built from scratch and deleted afterwards, as on a fresh start
+template<typename F>
+double measure(const vector<string>& files, F loadOne)
+{
+	auto start = chrono::high_resolution_clock::now();
+	vector<Texture*> textures;
+	for (const string& file : files)
+	{
+		Texture* texture = new Texture();
+		texture->setMipmapEnabled(true);
+		loadOne(*texture, file.c_str());
+		textures.push_back(texture);
+	}
+	glFinish();
+	auto end = chrono::high_resolution_clock::now();
+	for (Texture* texture : textures)
+		delete texture;
+	return chrono::duration<double, milli>(end - start).count();
+}
+
+void report(const char* name, double ms, size_t count)
+{
+	cout << left << setw(14) << name << right << fixed << setprecision(2) << setw(10) << ms << " ms"
+		<< setw(10) << ms / count << " ms/texture\n";
+}
+
+int main(int argc, char** argv)
+{
+	const char* imageDirectory = argc > 1 ? argv[1] : "../data";
+	const char* cacheDirectory = argc > 2 ? argv[2] : "bench_texture_cache";
+
+	vector<string> files;
+	error_code error;
+	for (filesystem::directory_iterator it(imageDirectory, error), end; !error && it != end; it.increment(error))
+		if (it->is_regular_file() && isImage(it->path()))
+			files.push_back(it->path().string());
+	if (files.empty())
+	{
+		cout << "No images found in \"" << imageDirectory << "\"" << endl;
+		return -1;
+	}
+	sort(files.begin(), files.end());
+
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	GLFWwindow* window = glfwCreateWindow(64, 64, "TextureCache", NULL, NULL);
+	if (window == NULL)
+	{
+		cout << "Failed to create GLFW window" << endl;
+		glfwTerminate();
+		return -1;
+	}
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		cout << "Failed to initialize GLAD" << endl;
+		return -1;
+	}
+
+	// the cold pass has to start from an empty cache
+	filesystem::remove_all(cacheDirectory, error);
+	TextureCache cache(cacheDirectory);
+
+	cout << files.size() << " images from \"" << imageDirectory << "\", cache in \"" << cacheDirectory << "\"\n";
+
+	double uncached = measure(files, [](Texture& texture, const char* file) { texture.load(file); texture.generate(); });
+	double cold = measure(files, [&cache](Texture& texture, const char* file) { cache.get(texture, file); });
+	double warm = measure(files, [&cache](Texture& texture, const char* file) { cache.get(texture, file); });
+
+	report("no cache", uncached, files.size());
+	report("cold cache", cold, files.size());
+	report("warm cache", warm, files.size());
+	cout << "warm start is " << fixed << setprecision(2) << uncached / warm << "x faster than no cache\n";
+
+	glfwTerminate();
+	return 0;
+}
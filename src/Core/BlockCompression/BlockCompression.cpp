@@ -0,0 +1,331 @@
+#include "BlockCompression.h"
+#include "ThreadPool/ThreadPool.h"
+
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace XGL
+{
+	namespace
+	{
+		unsigned short pack565(const int* color)
+		{
+			return (unsigned short)(((color[0] * 31 + 127) / 255) << 11 | ((color[1] * 63 + 127) / 255) << 5 | (color[2] * 31 + 127) / 255);
+		}
+
+		void unpack565(unsigned short packed, int* color)
+		{
+			int r = packed >> 11, g = packed >> 5 & 0x3f, b = packed & 0x1f;
+			color[0] = r << 3 | r >> 2;
+			color[1] = g << 2 | g >> 4;
+			color[2] = b << 3 | b >> 2;
+		}
+	}
+
+	size_t BlockCompression::getSize(Format format, int width, int height)
+	{
+		return (size_t)((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(format);
+	}
+
+	unsigned int BlockCompression::getFormatGL(Format format, bool sRGB)
+	{
+		if (sRGB)
+			return format == BC1 ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+		return format == BC1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	}
+
+	void BlockCompression::blockBounds(const unsigned char* block, int* min, int* max)
+	{
+#ifdef XGL_SIMD_SSE
+		const __m128i* texels = (const __m128i*)block;
+		__m128i lo = _mm_min_epu8(_mm_min_epu8(_mm_loadu_si128(texels), _mm_loadu_si128(texels + 1)),
+			_mm_min_epu8(_mm_loadu_si128(texels + 2), _mm_loadu_si128(texels + 3)));
+		__m128i hi = _mm_max_epu8(_mm_max_epu8(_mm_loadu_si128(texels), _mm_loadu_si128(texels + 1)),
+			_mm_max_epu8(_mm_loadu_si128(texels + 2), _mm_loadu_si128(texels + 3)));
+		// fold the 4 texels of each register into the lowest one
+		lo = _mm_min_epu8(lo, _mm_srli_si128(lo, 8));
+		lo = _mm_min_epu8(lo, _mm_srli_si128(lo, 4));
+		hi = _mm_max_epu8(hi, _mm_srli_si128(hi, 8));
+		hi = _mm_max_epu8(hi, _mm_srli_si128(hi, 4));
+		unsigned int packedMin = (unsigned int)_mm_cvtsi128_si32(lo);
+		unsigned int packedMax = (unsigned int)_mm_cvtsi128_si32(hi);
+		for (int c = 0; c < 4; c++)
+		{
+			min[c] = packedMin >> (8 * c) & 0xff;
+			max[c] = packedMax >> (8 * c) & 0xff;
+		}
+#else
+		for (int c = 0; c < 4; c++)
+		{
+			min[c] = 255;
+			max[c] = 0;
+		}
+		for (int i = 0; i < 16; i++)
+			for (int c = 0; c < 4; c++)
+			{
+				int v = block[4 * i + c];
+				min[c] = v < min[c] ? v : min[c];
+				max[c] = v > max[c] ? v : max[c];
+			}
+#endif
+	}
+
+	void BlockCompression::fetchBlock(const unsigned char* pixels, int width, int height, int channel, int blockX, int blockY, unsigned char* block)
+	{
+		for (int y = 0; y < 4; y++)
+			for (int x = 0; x < 4; x++)
+			{
+				// partial blocks at the border repeat the last row and column
+				int px = blockX * 4 + x < width ? blockX * 4 + x : width - 1;
+				int py = blockY * 4 + y < height ? blockY * 4 + y : height - 1;
+				const unsigned char* src = pixels + ((size_t)py * width + px) * channel;
+				unsigned char* dst = block + 4 * (y * 4 + x);
+				switch (channel)
+				{
+					case 1:
+						dst[0] = dst[1] = dst[2] = src[0]; dst[3] = 255; break;
+					case 2:
+						dst[0] = dst[1] = dst[2] = src[0]; dst[3] = src[1]; break;
+					case 3:
+						dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = 255; break;
+					default:
+						dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3]; break;
+				}
+			}
+	}
+
+	void BlockCompression::encodeColor(const unsigned char* block, unsigned char* out)
+	{
+		int min[4], max[4];
+		blockBounds(block, min, max);
+
+		// run the diagonal of the bounding box along the block's trend: channels falling as the widest one rises are flipped
+		int ref = 0;
+		for (int c = 1; c < 3; c++)
+			if (max[c] - min[c] > max[ref] - min[ref])
+				ref = c;
+		int mean[3] = { 0, 0, 0 };
+		for (int i = 0; i < 16; i++)
+			for (int c = 0; c < 3; c++)
+				mean[c] += block[4 * i + c];
+		int cov[3] = { 0, 0, 0 };
+		for (int i = 0; i < 16; i++)
+		{
+			int d = 16 * block[4 * i + ref] - mean[ref];
+			for (int c = 0; c < 3; c++)
+				cov[c] += d * (16 * block[4 * i + c] - mean[c]);
+		}
+
+		int end0[3], end1[3];
+		for (int c = 0; c < 3; c++)
+		{
+			int inset = (max[c] - min[c]) >> 4;
+			int hi = max[c] - inset, lo = min[c] + inset;
+			end0[c] = cov[c] < 0 ? lo : hi;
+			end1[c] = cov[c] < 0 ? hi : lo;
+		}
+
+		unsigned short packed0 = pack565(end0), packed1 = pack565(end1);
+		// the four color mode needs packed0 > packed1, swapping the ends keeps the same palette
+		if (packed0 < packed1)
+		{
+			unsigned short t = packed0;
+			packed0 = packed1;
+			packed1 = t;
+		}
+		out[0] = packed0 & 0xff;
+		out[1] = packed0 >> 8;
+		out[2] = packed1 & 0xff;
+		out[3] = packed1 >> 8;
+
+		unsigned int indices = 0;
+		if (packed0 != packed1)
+		{
+			int color0[3], color1[3], dir[3];
+			unpack565(packed0, color0);
+			unpack565(packed1, color1);
+			for (int c = 0; c < 3; c++)
+				dir[c] = color0[c] - color1[c];
+			int length2 = dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2];
+			// palette order along dir is color1, 2/3 color1 + 1/3 color0, 1/3 color1 + 2/3 color0, color0
+			static const unsigned int remap[4] = { 1, 3, 2, 0 };
+			for (int i = 15; i >= 0; i--)
+			{
+				int t = 0;
+				for (int c = 0; c < 3; c++)
+					t += (block[4 * i + c] - color1[c]) * dir[c];
+				t *= 6;
+				int step = t < length2 ? 0 : t < 3 * length2 ? 1 : t < 5 * length2 ? 2 : 3;
+				indices = indices << 2 | remap[step];
+			}
+		}
+		out[4] = indices & 0xff;
+		out[5] = indices >> 8 & 0xff;
+		out[6] = indices >> 16 & 0xff;
+		out[7] = indices >> 24;
+	}
+
+	void BlockCompression::encodeAlpha(const unsigned char* block, unsigned char* out)
+	{
+		int min[4], max[4];
+		blockBounds(block, min, max);
+		int alpha0 = max[3], alpha1 = min[3];
+		out[0] = (unsigned char)alpha0;
+		out[1] = (unsigned char)alpha1;
+
+		unsigned long long indices = 0;
+		if (alpha0 != alpha1)
+		{
+			// the eight value mode, ordered from alpha1 up to alpha0
+			static const unsigned long long remap[8] = { 1, 7, 6, 5, 4, 3, 2, 0 };
+			int range = alpha0 - alpha1;
+			for (int i = 15; i >= 0; i--)
+			{
+				int step = ((block[4 * i + 3] - alpha1) * 14 + range) / (2 * range);
+				indices = indices << 3 | remap[step];
+			}
+		}
+		for (int i = 0; i < 6; i++)
+			out[2 + i] = (unsigned char)(indices >> (8 * i));
+	}
+
+	void BlockCompression::encodeRows(Format format, const unsigned char* pixels, int width, int height, int channel,
+		unsigned char* out, int rowBegin, int rowEnd)
+	{
+		int blocksX = (width + 3) / 4;
+		size_t blockSize = getBlockSize(format);
+		unsigned char block[64];
+		for (int by = rowBegin; by < rowEnd; by++)
+			for (int bx = 0; bx < blocksX; bx++)
+			{
+				unsigned char* dst = out + ((size_t)by * blocksX + bx) * blockSize;
+				fetchBlock(pixels, width, height, channel, bx, by, block);
+				if (format == BC3)
+				{
+					encodeAlpha(block, dst);
+					dst += 8;
+				}
+				encodeColor(block, dst);
+			}
+	}
+
+	void BlockCompression::encode(Format format, const unsigned char* pixels, int width, int height, int channel, unsigned char* out)
+	{
+		if (channel < 1 || channel > 4)
+		{
+			std::cerr << "ERROR | XGL::BlockCompression::encode(Format, const unsigned char*, int, int, int, unsigned char*) : Invalid channel count.\n";
+			throw INVALID_CHANNEL;
+		}
+		encodeRows(format, pixels, width, height, channel, out, 0, (height + 3) / 4);
+	}
+
+	void BlockCompression::encodeParallel(Format format, const unsigned char* pixels, int width, int height, int channel, unsigned char* out,
+		bool parallel)
+	{
+		if (channel < 1 || channel > 4)
+		{
+			std::cerr << "ERROR | XGL::BlockCompression::encodeParallel(Format, const unsigned char*, int, int, int, unsigned char*, bool) : Invalid channel count.\n";
+			throw INVALID_CHANNEL;
+		}
+		int rows = (height + 3) / 4;
+		if (!parallel)
+		{
+			encodeRows(format, pixels, width, height, channel, out, 0, rows);
+			return;
+		}
+		ThreadPool::global().parallelFor(0, rows, (int)minParallelRows, [=](int rowBegin, int rowEnd)
+		{
+			encodeRows(format, pixels, width, height, channel, out, rowBegin, rowEnd);
+		});
+	}
+
+	void BlockCompression::decodeColor(const unsigned char* in, bool opaque, unsigned char* block)
+	{
+		unsigned short packed0 = in[0] | in[1] << 8, packed1 = in[2] | in[3] << 8;
+		int palette[4][4];
+		unpack565(packed0, palette[0]);
+		unpack565(packed1, palette[1]);
+		palette[0][3] = palette[1][3] = 255;
+		for (int c = 0; c < 3; c++)
+		{
+			if (opaque || packed0 > packed1)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+		palette[2][3] = 255;
+		palette[3][3] = opaque || packed0 > packed1 ? 255 : 0;
+
+		unsigned int indices = in[4] | in[5] << 8 | in[6] << 16 | (unsigned int)in[7] << 24;
+		for (int i = 0; i < 16; i++)
+			for (int c = 0; c < 4; c++)
+				block[4 * i + c] = (unsigned char)palette[indices >> (2 * i) & 3][c];
+	}
+
+	void BlockCompression::decodeAlpha(const unsigned char* in, unsigned char* block)
+	{
+		int palette[8];
+		palette[0] = in[0];
+		palette[1] = in[1];
+		if (palette[0] > palette[1])
+			for (int i = 2; i < 8; i++)
+				palette[i] = ((8 - i) * palette[0] + (i - 1) * palette[1]) / 7;
+		else
+		{
+			for (int i = 2; i < 6; i++)
+				palette[i] = ((6 - i) * palette[0] + (i - 1) * palette[1]) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		unsigned long long indices = 0;
+		for (int i = 0; i < 6; i++)
+			indices |= (unsigned long long)in[2 + i] << (8 * i);
+		for (int i = 0; i < 16; i++)
+			block[4 * i + 3] = (unsigned char)palette[indices >> (3 * i) & 7];
+	}
+
+	void BlockCompression::decode(Format format, const unsigned char* in, int width, int height, unsigned char* pixels)
+	{
+		int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+		size_t blockSize = getBlockSize(format);
+		unsigned char block[64];
+		for (int by = 0; by < blocksY; by++)
+			for (int bx = 0; bx < blocksX; bx++)
+			{
+				const unsigned char* src = in + ((size_t)by * blocksX + bx) * blockSize;
+				if (format == BC3)
+				{
+					decodeColor(src + 8, true, block);
+					decodeAlpha(src, block);
+				}
+				else
+					decodeColor(src, false, block);
+				for (int y = 0; y < 4 && by * 4 + y < height; y++)
+					for (int x = 0; x < 4 && bx * 4 + x < width; x++)
+						for (int c = 0; c < 4; c++)
+							pixels[(((size_t)by * 4 + y) * width + bx * 4 + x) * 4 + c] = block[4 * (y * 4 + x) + c];
+			}
+	}
+
+	double BlockCompression::psnr(const unsigned char* lOpnt, const unsigned char* rOpnt, size_t size)
+	{
+		double error = 0;
+		for (size_t i = 0; i < size; i++)
+		{
+			double d = (double)lOpnt[i] - rOpnt[i];
+			error += d * d;
+		}
+		if (error == 0)
+			return std::numeric_limits<double>::infinity();
+		return 10 * log10(255.0 * 255.0 * size / error);
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef XGL_BLOCKCOMPRESSION_H
+#define XGL_BLOCKCOMPRESSION_H
+
+#include <Math/SIMD.h>
+#include <cstddef>
+
+// S3TC enums, EXT_texture_compression_s3tc is not part of the 3.3 core GLAD headers
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+	#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+namespace XGL
+{
+	// CPU encoder and decoder of the BC1 ( DXT1, opaque ) and BC3 ( DXT5, interpolated alpha ) 4x4 block formats.
+	// Endpoints are the channel bounds of the block, bounds taken with SSE2 where available, oriented along the
+	// block's dominant diagonal and inset by 1/16 of the range; since the palette is colinear, texels are assigned
+	// by their projection on it.
+	// Sources are 8 bit with 1 to 4 channels, 1 and 2 channels being gray and gray with alpha.
+	class BlockCompression
+	{
+		public:
+			enum ERROR { INVALID_CHANNEL };
+			enum Format { BC1, BC3 };
+
+			// images with fewer block rows per thread are encoded on the calling thread
+			static const size_t minParallelRows = 16;
+
+		private:
+			// per channel minimum and maximum of the 16 RGBA texels of a block
+			static void blockBounds(const unsigned char* block, int* min, int* max);
+			static void fetchBlock(const unsigned char* pixels, int width, int height, int channel, int blockX, int blockY, unsigned char* block);
+			static void encodeColor(const unsigned char* block, unsigned char* out);
+			static void encodeAlpha(const unsigned char* block, unsigned char* out);
+			static void encodeRows(Format format, const unsigned char* pixels, int width, int height, int channel,
+				unsigned char* out, int rowBegin, int rowEnd);
+			static void decodeColor(const unsigned char* in, bool opaque, unsigned char* block);
+			static void decodeAlpha(const unsigned char* in, unsigned char* block);
+
+		public:
+			static size_t getBlockSize(Format format) { return format == BC1 ? 8 : 16; }
+			static size_t getSize(Format format, int width, int height);
+			// with sRGB the EXT_texture_sRGB variant, decoded to linear when sampled
+			static unsigned int getFormatGL(Format format, bool sRGB = false);
+
+			static void encode(Format format, const unsigned char* pixels, int width, int height, int channel, unsigned char* out);
+			// one range of block rows per worker of ThreadPool::global(), same output as encode();
+			// on the pool's own workers parallel must be false, the caller would wait on jobs queued behind itself
+			static void encodeParallel(Format format, const unsigned char* pixels, int width, int height, int channel, unsigned char* out,
+				bool parallel = true);
+			// pixels receives width * height RGBA texels
+			static void decode(Format format, const unsigned char* in, int width, int height, unsigned char* pixels);
+
+			// peak signal to noise ratio in dB of two 8 bit buffers, infinite when they are equal
+			static double psnr(const unsigned char* lOpnt, const unsigned char* rOpnt, size_t size);
+	};
+}
+
+#endif // !XGL_BLOCKCOMPRESSION_H
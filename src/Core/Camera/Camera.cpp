@@ -4,40 +4,52 @@ namespace XGL
 {
 	void Camera::updateAxis()
 	{
-		view = View::lookAt(position, position + front, up);
+		view = View::lookAt(position, (position + front).eval(), up);
+		orientation = Quat::fromMatrix(view).conjugate();
 		updateToAxis();
 		updateToEuler();
+		blockDirty = true;
 	}
 
 	void Camera::updateEuler()
 	{
-		view = View::euler(position, yaw, pitch, roll);
+		orientation = Quat::fromEuler(yaw, pitch, roll);
+		updateOrientation();
+	}
+
+	void Camera::updateOrientation()
+	{
+		view = View::orientation(position, orientation);
 		updateToAxis();
+		blockDirty = true;
 	}
 
 	void Camera::updatePosition()
 	{
-		view(0, 3) = view(0, 0) * -position.x() + view(0, 1) * -position.y() + view(0, 2) * -position.z();
-		view(1, 3) = view(1, 0) * -position.x() + view(1, 1) * -position.y() + view(1, 2) * -position.z();
-		view(2, 3) = view(2, 0) * -position.x() + view(2, 1) * -position.y() + view(2, 2) * -position.z();
+		view.elem(0, 3) = view.elem(0, 0) * -position.x() + view.elem(0, 1) * -position.y() + view.elem(0, 2) * -position.z();
+		view.elem(1, 3) = view.elem(1, 0) * -position.x() + view.elem(1, 1) * -position.y() + view.elem(1, 2) * -position.z();
+		view.elem(2, 3) = view.elem(2, 0) * -position.x() + view.elem(2, 1) * -position.y() + view.elem(2, 2) * -position.z();
+		blockDirty = true;
 	}
 
 	void Camera::updateLen()
 	{
 		projection = Projection::perspFov(fov, aspect, near, far);
+		lenDirty = false;
+		blockDirty = true;
 	}
 
 	void Camera::updateToAxis()
 	{
-		front.x() = -view(2, 0);
-		front.y() = -view(2, 1);
-		front.z() = -view(2, 2);
-		right.x() = view(0, 0);
-		right.y() = view(0, 1);
-		right.z() = view(0, 2);
-		up.x() = view(1, 0);
-		up.y() = view(1, 1);
-		up.z() = view(1, 2);
+		front.x() = -view.elem(2, 0);
+		front.y() = -view.elem(2, 1);
+		front.z() = -view.elem(2, 2);
+		right.x() = view.elem(0, 0);
+		right.y() = view.elem(0, 1);
+		right.z() = view.elem(0, 2);
+		up.x() = view.elem(1, 0);
+		up.y() = view.elem(1, 1);
+		up.z() = view.elem(1, 2);
 	}
 
 	void Camera::updateToEuler()
@@ -47,7 +59,7 @@ namespace XGL
 		roll = 0;
 	}
 
-	Camera::Camera()
+	Camera::Camera() : block(NULL), blockDirty(true), lenDirty(false)
 	{
 		yaw = pitch = roll = 0;
 		target_yaw = target_pitch = target_roll = 0;
@@ -75,6 +87,15 @@ namespace XGL
 		target_pitch = pitch;
 		target_roll = roll;
 	}
+
+	void Camera::setOrientation(const Quat& rotation)
+	{
+		Vec3 euler = rotation.normalize().toEuler();
+		target_yaw = euler.x();
+		target_pitch = euler.y();
+		target_roll = euler.z();
+	}
+
 	void Camera::setLen(float fov, float aspect, float near, float far)
 	{
 		if (fov > 2 * PI / 3 || fov < PI / 18)
@@ -84,6 +105,7 @@ namespace XGL
 		this->aspect = aspect;
 		this->near = near;
 		this->far = far;
+		lenDirty = true;
 	}
 
 	void Camera::setFov(float fov)
@@ -102,6 +124,7 @@ namespace XGL
 			throw INVALID_SET_VALUE;
 		}
 		this->aspect = aspect;
+		lenDirty = true;
 	}
 
 	void Camera::moveForward(float distance)
@@ -230,19 +253,48 @@ namespace XGL
 		float k;
 
 		k = 1 / (1 + smooth_euler / deltaT);
-		yaw = target_yaw * k + yaw * (1 - k);
-		pitch = target_pitch * k + pitch * (1 - k);
-		roll = target_roll * k + roll * (1 - k);
+		float newYaw = target_yaw * k + yaw * (1 - k);
+		float newPitch = target_pitch * k + pitch * (1 - k);
+		float newRoll = target_roll * k + roll * (1 - k);
+		bool rotated = newYaw != yaw || newPitch != pitch || newRoll != roll;
+		yaw = newYaw;
+		pitch = newPitch;
+		roll = newRoll;
 
 		k = 1 / (1 + smooth_position / deltaT);
-		position = target_position * k + position * (1 - k);
+		Vec3 newPosition = target_position * k + position * (1 - k);
+		bool moved = newPosition != position;
+		position = newPosition;
 
-		updateEuler();
+		// the rotation only needs rebuilding while the angles change, a pure move just shifts the view
+		if (rotated)
+			updateEuler();
+		else if (moved)
+			updatePosition();
 
 		k = 1 / (1 + smooth_fov / deltaT);
-		fov = target_fov * k + fov * (1 - k);
-		updateLen();
-
+		float newFov = target_fov * k + fov * (1 - k);
+		bool zoomed = newFov != fov;
+		fov = newFov;
+
+		if (zoomed || lenDirty)
+			updateLen();
+	}
+
+	void Camera::publish()
+	{
+		if (!block)
+			block = new UniformBlock<CameraBlock>(blockBinding);
+		// another camera may have taken the binding point since the last call
+		block->bind();
+		if (!blockDirty)
+			return;
+		CameraBlock& data = block->edit();
+		data.view = view;
+		data.projection = projection;
+		data.viewProjection = projection * view;
+		block->upload();
+		blockDirty = false;
 	}
 
 	Mat4& Camera::viewMat()
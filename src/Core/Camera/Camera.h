@@ -3,15 +3,31 @@
 
 #include <Math/View.h>
 #include <Math/Projection.h>
+#include <Math/Quaternion.h>
 #include <Math/Tool.h>
+#include "UniformBlock/UniformBlock.h"
 
 namespace XGL
 {
+	// layout(std140) uniform Camera { mat4 view; mat4 projection; mat4 viewProjection; };
+	typedef struct
+	{
+		Mat4 view;
+		Mat4 projection;
+		Mat4 viewProjection;
+	} CameraBlock;
+	XGL_STD140_MEMBER(CameraBlock, view);
+	XGL_STD140_MEMBER(CameraBlock, projection);
+	XGL_STD140_MEMBER(CameraBlock, viewProjection);
+
 	class Camera
 	{
 		public:
 			enum ERROR { INVALID_SET_VALUE };
 
+			// binding point of the Camera block, set up by Program::link(), shared by every camera
+			static const unsigned int blockBinding = 0;
+
 		private:
 			// --- position ---
 			Vec3 position;
@@ -32,6 +48,9 @@ namespace XGL
 			float target_roll;
 			float smooth_euler;
 
+			// --- orientation ---
+			Quat orientation;
+
 			// --- len ---
 			float fov;
 			float aspect;
@@ -43,10 +62,14 @@ namespace XGL
 			// --- output ---
 			Mat4 view;
 			Mat4 projection;
+			UniformBlock<CameraBlock>* block;	// created by the first publish(), needs a GL context
+			bool blockDirty;
+			bool lenDirty;	// aspect, near or far changed since the last updateLen()
 
 			// --- update from property ---
 			void updateAxis();
 			void updateEuler();
+			void updateOrientation();
 			void updatePosition();
 			void updateLen();
 
@@ -56,10 +79,13 @@ namespace XGL
 
 		public:
 			Camera();
-			~Camera() {}
+			Camera(const Camera&) = delete;
+			Camera& operator=(const Camera&) = delete;
+			~Camera() { delete block; }
 
 			void setPosition(Vec3 pos);
 			void setEuler(float yaw, float pitch, float roll = 0);
+			void setOrientation(const Quat& rotation);
 			void setLen(float fov, float aspect, float near = 0.1, float far = 100);
 			void setFov(float fov);
 			void setAspect(float aspect);
@@ -91,9 +117,15 @@ namespace XGL
 			void smoothZoom(float factor);
 
 			void update(float deltaT);
+			// binds this camera's block to blockBinding, uploading view, projection and their product
+			// if they changed since the last call
+			void publish();
 
 			Mat4& viewMat();
 			Mat4& projectionMat();
+			const Quat& getOrientation() const { return orientation; }
+			float getNear() const { return near; }
+			float getFar() const { return far; }
 	};
 }
 
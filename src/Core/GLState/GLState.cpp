@@ -0,0 +1,338 @@
+#include "GLState.h"
+
+#include <GLFW/glfw3.h>
+#include <cstring>
+
+namespace XGL
+{
+	unsigned int GLState::program = 0;
+	unsigned int GLState::vertexArray = 0;
+	unsigned int GLState::arrayBuffer = 0;
+	unsigned int GLState::elementBuffer = 0;
+	unsigned int GLState::activeUnit = 0;
+	unsigned int GLState::textures[GLState::maxTextureUnits] = {};
+	unsigned int GLState::uniformBuffers[GLState::maxUniformBindings] = {};
+
+	unsigned long long GLState::issuedCount = 0;
+	unsigned long long GLState::elidedCount = 0;
+
+	bool GLState::dsaChecked = false;
+	bool GLState::dsaAvailable = false;
+	GLState::ProgramUniform1iProc GLState::programUniform1iProc = NULL;
+	GLState::ProgramUniform1fProc GLState::programUniform1fProc = NULL;
+	GLState::ProgramUniformfvProc GLState::programUniform2fvProc = NULL;
+	GLState::ProgramUniformfvProc GLState::programUniform3fvProc = NULL;
+	GLState::ProgramUniformfvProc GLState::programUniform4fvProc = NULL;
+	GLState::ProgramUniformMatrixfvProc GLState::programUniformMatrix2fvProc = NULL;
+	GLState::ProgramUniformMatrixfvProc GLState::programUniformMatrix3fvProc = NULL;
+	GLState::ProgramUniformMatrixfvProc GLState::programUniformMatrix4fvProc = NULL;
+
+	bool GLState::indirectChecked = false;
+	bool GLState::indirectAvailable = false;
+	GLState::MultiDrawElementsIndirectProc GLState::multiDrawElementsIndirectProc = NULL;
+
+	bool GLState::storageChecked = false;
+	bool GLState::storageAvailable = false;
+	GLState::BufferStorageProc GLState::bufferStorageProc = NULL;
+
+	int GLState::getVersion()
+	{
+		int major, minor;
+		glGetIntegerv(GL_MAJOR_VERSION, &major);
+		glGetIntegerv(GL_MINOR_VERSION, &minor);
+		return major * 10 + minor;
+	}
+
+	bool GLState::hasExtension(const char* name)
+	{
+		int count;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (int i = 0; i < count; i++)
+			if (!strcmp((const char*)glGetStringi(GL_EXTENSIONS, i), name))
+				return true;
+		return false;
+	}
+
+	void GLState::loadDSA()
+	{
+		dsaChecked = true;
+		// GLAD is generated for 3.3 core, the entry points are fetched here
+		if (getVersion() < 41 && !hasExtension("GL_ARB_separate_shader_objects"))
+			return;
+		programUniform1iProc = (ProgramUniform1iProc)glfwGetProcAddress("glProgramUniform1i");
+		programUniform1fProc = (ProgramUniform1fProc)glfwGetProcAddress("glProgramUniform1f");
+		programUniform2fvProc = (ProgramUniformfvProc)glfwGetProcAddress("glProgramUniform2fv");
+		programUniform3fvProc = (ProgramUniformfvProc)glfwGetProcAddress("glProgramUniform3fv");
+		programUniform4fvProc = (ProgramUniformfvProc)glfwGetProcAddress("glProgramUniform4fv");
+		programUniformMatrix2fvProc = (ProgramUniformMatrixfvProc)glfwGetProcAddress("glProgramUniformMatrix2fv");
+		programUniformMatrix3fvProc = (ProgramUniformMatrixfvProc)glfwGetProcAddress("glProgramUniformMatrix3fv");
+		programUniformMatrix4fvProc = (ProgramUniformMatrixfvProc)glfwGetProcAddress("glProgramUniformMatrix4fv");
+		dsaAvailable = programUniform1iProc && programUniform1fProc
+			&& programUniform2fvProc && programUniform3fvProc && programUniform4fvProc
+			&& programUniformMatrix2fvProc && programUniformMatrix3fvProc && programUniformMatrix4fvProc;
+	}
+
+	void GLState::loadIndirect()
+	{
+		indirectChecked = true;
+		if (getVersion() < 43 && !(hasExtension("GL_ARB_multi_draw_indirect") && hasExtension("GL_ARB_base_instance")))
+			return;
+		multiDrawElementsIndirectProc = (MultiDrawElementsIndirectProc)glfwGetProcAddress("glMultiDrawElementsIndirect");
+		indirectAvailable = multiDrawElementsIndirectProc != NULL;
+	}
+
+	void GLState::loadStorage()
+	{
+		storageChecked = true;
+		if (getVersion() < 44 && !hasExtension("GL_ARB_buffer_storage"))
+			return;
+		bufferStorageProc = (BufferStorageProc)glfwGetProcAddress("glBufferStorage");
+		storageAvailable = bufferStorageProc != NULL;
+	}
+
+	bool GLState::change(unsigned int& shadow, unsigned int value)
+	{
+		if (shadow == value)
+		{
+			elidedCount++;
+			return false;
+		}
+		issuedCount++;
+		shadow = value;
+		return true;
+	}
+
+	void GLState::useProgram(unsigned int program)
+	{
+		if (change(GLState::program, program))
+			glUseProgram(program);
+	}
+
+	void GLState::bindVertexArray(unsigned int vertexArray)
+	{
+		if (change(GLState::vertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+			elementBuffer = ~0u;
+		}
+	}
+
+	void GLState::bindBuffer(GLenum target, unsigned int buffer)
+	{
+		if (target == GL_ARRAY_BUFFER)
+		{
+			if (change(arrayBuffer, buffer))
+				glBindBuffer(target, buffer);
+		}
+		else if (target == GL_ELEMENT_ARRAY_BUFFER)
+		{
+			if (change(elementBuffer, buffer))
+				glBindBuffer(target, buffer);
+		}
+		else
+		{
+			issuedCount++;
+			glBindBuffer(target, buffer);
+		}
+	}
+
+	void GLState::activeTexture(unsigned int unit)
+	{
+		if (change(activeUnit, unit))
+			glActiveTexture(GL_TEXTURE0 + unit);
+	}
+
+	void GLState::bindTexture(unsigned int unit, unsigned int texture)
+	{
+		if (unit >= maxTextureUnits)
+		{
+			activeTexture(unit);
+			issuedCount++;
+			glBindTexture(GL_TEXTURE_2D, texture);
+			return;
+		}
+		if (textures[unit] == texture)
+		{
+			elidedCount++;
+			return;
+		}
+		activeTexture(unit);
+		change(textures[unit], texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+	}
+
+	void GLState::bindUniformBuffer(unsigned int index, unsigned int buffer)
+	{
+		if (index >= maxUniformBindings)
+		{
+			issuedCount++;
+			glBindBufferBase(GL_UNIFORM_BUFFER, index, buffer);
+			return;
+		}
+		if (change(uniformBuffers[index], buffer))
+			glBindBufferBase(GL_UNIFORM_BUFFER, index, buffer);
+	}
+
+	void GLState::forgetProgram(unsigned int program)
+	{
+		// a deleted program stays in use until another one is bound
+		if (GLState::program == program)
+			useProgram(0);
+	}
+
+	void GLState::forgetVertexArray(unsigned int vertexArray)
+	{
+		// deleting a bound object reverts its binding to 0
+		if (GLState::vertexArray == vertexArray)
+		{
+			GLState::vertexArray = 0;
+			elementBuffer = ~0u;
+		}
+	}
+
+	void GLState::forgetBuffer(unsigned int buffer)
+	{
+		if (arrayBuffer == buffer)
+			arrayBuffer = 0;
+		if (elementBuffer == buffer)
+			elementBuffer = 0;
+		for (unsigned int i = 0; i < maxUniformBindings; i++)
+			if (uniformBuffers[i] == buffer)
+				uniformBuffers[i] = 0;
+	}
+
+	void GLState::forgetTexture(unsigned int texture)
+	{
+		for (unsigned int i = 0; i < maxTextureUnits; i++)
+			if (textures[i] == texture)
+				textures[i] = 0;
+	}
+
+	void GLState::invalidate()
+	{
+		program = vertexArray = arrayBuffer = elementBuffer = activeUnit = ~0u;
+		for (unsigned int i = 0; i < maxTextureUnits; i++)
+			textures[i] = ~0u;
+		for (unsigned int i = 0; i < maxUniformBindings; i++)
+			uniformBuffers[i] = ~0u;
+	}
+
+	bool GLState::hasDSA()
+	{
+		if (!dsaChecked)
+			loadDSA();
+		return dsaAvailable;
+	}
+
+	void GLState::programUniform1i(unsigned int program, int location, int value)
+	{
+		if (hasDSA())
+			programUniform1iProc(program, location, value);
+		else
+		{
+			useProgram(program);
+			glUniform1i(location, value);
+		}
+	}
+
+	void GLState::programUniform1f(unsigned int program, int location, float value)
+	{
+		if (hasDSA())
+			programUniform1fProc(program, location, value);
+		else
+		{
+			useProgram(program);
+			glUniform1f(location, value);
+		}
+	}
+
+	void GLState::programUniform2fv(unsigned int program, int location, const float* value)
+	{
+		if (hasDSA())
+			programUniform2fvProc(program, location, 1, value);
+		else
+		{
+			useProgram(program);
+			glUniform2fv(location, 1, value);
+		}
+	}
+
+	void GLState::programUniform3fv(unsigned int program, int location, const float* value)
+	{
+		if (hasDSA())
+			programUniform3fvProc(program, location, 1, value);
+		else
+		{
+			useProgram(program);
+			glUniform3fv(location, 1, value);
+		}
+	}
+
+	void GLState::programUniform4fv(unsigned int program, int location, const float* value)
+	{
+		if (hasDSA())
+			programUniform4fvProc(program, location, 1, value);
+		else
+		{
+			useProgram(program);
+			glUniform4fv(location, 1, value);
+		}
+	}
+
+	void GLState::programUniformMatrix2fv(unsigned int program, int location, bool transpose, const float* value)
+	{
+		if (hasDSA())
+			programUniformMatrix2fvProc(program, location, 1, transpose, value);
+		else
+		{
+			useProgram(program);
+			glUniformMatrix2fv(location, 1, transpose, value);
+		}
+	}
+
+	void GLState::programUniformMatrix3fv(unsigned int program, int location, bool transpose, const float* value)
+	{
+		if (hasDSA())
+			programUniformMatrix3fvProc(program, location, 1, transpose, value);
+		else
+		{
+			useProgram(program);
+			glUniformMatrix3fv(location, 1, transpose, value);
+		}
+	}
+
+	void GLState::programUniformMatrix4fv(unsigned int program, int location, bool transpose, const float* value)
+	{
+		if (hasDSA())
+			programUniformMatrix4fvProc(program, location, 1, transpose, value);
+		else
+		{
+			useProgram(program);
+			glUniformMatrix4fv(location, 1, transpose, value);
+		}
+	}
+
+	bool GLState::hasMultiDrawIndirect()
+	{
+		if (!indirectChecked)
+			loadIndirect();
+		return indirectAvailable;
+	}
+
+	void GLState::multiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, int drawCount, int stride)
+	{
+		multiDrawElementsIndirectProc(mode, type, indirect, drawCount, stride);
+	}
+
+	bool GLState::hasBufferStorage()
+	{
+		if (!storageChecked)
+			loadStorage();
+		return storageAvailable;
+	}
+
+	void GLState::bufferStorage(GLenum target, size_t size, const void* data, GLbitfield flags)
+	{
+		bufferStorageProc(target, size, data, flags);
+	}
+}
@@ -0,0 +1,132 @@
+#ifndef XGL_GLSTATE_H
+#define XGL_GLSTATE_H
+
+#include <glad/glad.h>
+
+#include <cstddef>
+
+// GL 4.x enums missing from the 3.3 core GLAD headers
+#ifndef GL_DRAW_INDIRECT_BUFFER
+	#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+	#define GL_MAP_PERSISTENT_BIT 0x0040
+	#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+namespace XGL
+{
+	// Shadow of the GL binding state: binds that would not change it are not sent to the driver.
+	// Code that binds through raw GL calls must call invalidate() before handing control back to XGL.
+	class GLState
+	{
+		public:
+			// per-unit texture bindings are shadowed for the first maxTextureUnits units, higher units always reach the driver
+			static const unsigned int maxTextureUnits = 32;
+			// indexed GL_UNIFORM_BUFFER bindings are shadowed for the first maxUniformBindings points
+			static const unsigned int maxUniformBindings = 16;
+
+		private:
+			typedef void (APIENTRYP ProgramUniform1iProc)(GLuint program, GLint location, GLint v0);
+			typedef void (APIENTRYP ProgramUniform1fProc)(GLuint program, GLint location, GLfloat v0);
+			typedef void (APIENTRYP ProgramUniformfvProc)(GLuint program, GLint location, GLsizei count, const GLfloat* value);
+			typedef void (APIENTRYP ProgramUniformMatrixfvProc)(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+			typedef void (APIENTRYP MultiDrawElementsIndirectProc)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+			typedef void (APIENTRYP BufferStorageProc)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+			// ~0u stands for unknown, it never equals a real name
+			static unsigned int program;
+			static unsigned int vertexArray;
+			static unsigned int arrayBuffer;
+			static unsigned int elementBuffer;	// part of the bound vertex array's state
+			static unsigned int activeUnit;
+			static unsigned int textures[maxTextureUnits];
+			static unsigned int uniformBuffers[maxUniformBindings];
+
+			static unsigned long long issuedCount;
+			static unsigned long long elidedCount;
+
+			// --- direct state access, GL 4.1 or ARB_separate_shader_objects ---
+			static bool dsaChecked;
+			static bool dsaAvailable;
+			static ProgramUniform1iProc programUniform1iProc;
+			static ProgramUniform1fProc programUniform1fProc;
+			static ProgramUniformfvProc programUniform2fvProc;
+			static ProgramUniformfvProc programUniform3fvProc;
+			static ProgramUniformfvProc programUniform4fvProc;
+			static ProgramUniformMatrixfvProc programUniformMatrix2fvProc;
+			static ProgramUniformMatrixfvProc programUniformMatrix3fvProc;
+			static ProgramUniformMatrixfvProc programUniformMatrix4fvProc;
+
+			// --- indirect draws, GL 4.3 or ARB_multi_draw_indirect with ARB_base_instance ---
+			static bool indirectChecked;
+			static bool indirectAvailable;
+			static MultiDrawElementsIndirectProc multiDrawElementsIndirectProc;
+
+			// --- immutable storage, GL 4.4 or ARB_buffer_storage ---
+			static bool storageChecked;
+			static bool storageAvailable;
+			static BufferStorageProc bufferStorageProc;
+
+			static int getVersion();
+			static bool hasExtension(const char* name);
+			static void loadDSA();
+			static void loadIndirect();
+			static void loadStorage();
+
+			// true when the call has to be issued, value is then recorded
+			static bool change(unsigned int& shadow, unsigned int value);
+
+		public:
+			static void useProgram(unsigned int program);
+			static void bindVertexArray(unsigned int vertexArray);
+			// GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER are shadowed, other targets are passed through
+			static void bindBuffer(GLenum target, unsigned int buffer);
+			static void activeTexture(unsigned int unit);
+			// GL_TEXTURE_2D binding of a texture unit
+			static void bindTexture(unsigned int unit, unsigned int texture);
+			// GL_UNIFORM_BUFFER binding point read by uniform blocks
+			static void bindUniformBuffer(unsigned int index, unsigned int buffer);
+
+			static unsigned int getProgram() { return program; }
+			static unsigned int getVertexArray() { return vertexArray; }
+			static unsigned int getActiveTexture() { return activeUnit; }
+
+			// to be called before deleting GL objects, so a recycled name is not taken as already bound
+			static void forgetProgram(unsigned int program);
+			static void forgetVertexArray(unsigned int vertexArray);
+			static void forgetBuffer(unsigned int buffer);
+			static void forgetTexture(unsigned int texture);
+
+			// forget everything, the next bind of each kind always reaches the driver
+			static void invalidate();
+
+			// binds sent to the driver and binds filtered out since the last resetCounters()
+			static unsigned long long getIssuedCount() { return issuedCount; }
+			static unsigned long long getElidedCount() { return elidedCount; }
+			static void resetCounters() { issuedCount = elidedCount = 0; }
+
+			// whether uniforms are written with glProgramUniform* rather than through the bound program
+			static bool hasDSA();
+
+			// uniform writes to any program, without changing the bound program when DSA is available
+			static void programUniform1i(unsigned int program, int location, int value);
+			static void programUniform1f(unsigned int program, int location, float value);
+			static void programUniform2fv(unsigned int program, int location, const float* value);
+			static void programUniform3fv(unsigned int program, int location, const float* value);
+			static void programUniform4fv(unsigned int program, int location, const float* value);
+			static void programUniformMatrix2fv(unsigned int program, int location, bool transpose, const float* value);
+			static void programUniformMatrix3fv(unsigned int program, int location, bool transpose, const float* value);
+			static void programUniformMatrix4fv(unsigned int program, int location, bool transpose, const float* value);
+
+			// whether multiDrawElementsIndirect() may be called, base instances included
+			static bool hasMultiDrawIndirect();
+			static void multiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, int drawCount, int stride);
+
+			// whether bufferStorage() may be called, persistent mapping included
+			static bool hasBufferStorage();
+			static void bufferStorage(GLenum target, size_t size, const void* data, GLbitfield flags);
+	};
+}
+
+#endif // !XGL_GLSTATE_H
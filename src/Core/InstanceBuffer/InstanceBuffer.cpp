@@ -0,0 +1,118 @@
+#include "InstanceBuffer.h"
+
+#include <Math/Transform.h>
+#include <iostream>
+
+namespace XGL
+{
+	InstanceBuffer::InstanceBuffer(unsigned int index) :
+		index(index), capacity(0), dirtyBegin(0), dirtyEnd(0)
+	{
+		glGenBuffers(1, &handle);
+	}
+
+	InstanceBuffer::~InstanceBuffer()
+	{
+		GLState::forgetBuffer(handle);
+		glDeleteBuffers(1, &handle);
+	}
+
+	void InstanceBuffer::markDirty(size_t begin, size_t end)
+	{
+		if (dirtyBegin == dirtyEnd)
+		{
+			dirtyBegin = begin;
+			dirtyEnd = end;
+			return;
+		}
+		dirtyBegin = begin < dirtyBegin ? begin : dirtyBegin;
+		dirtyEnd = end > dirtyEnd ? end : dirtyEnd;
+	}
+
+	void InstanceBuffer::resize(size_t size)
+	{
+		size_t oldSize = models.size();
+		models.resize(size);
+		if (size > oldSize)
+			markDirty(oldSize, size);
+	}
+
+	void InstanceBuffer::add(const Mat4& model)
+	{
+		models.push_back(model);
+		markDirty(models.size() - 1, models.size());
+	}
+
+	void InstanceBuffer::add(Vec3 position, const Quat& orientation, Vec3 scaling)
+	{
+		add(Transform::compose(position, orientation, scaling));
+	}
+
+	void InstanceBuffer::set(size_t idx, const Mat4& model)
+	{
+		if (idx >= models.size())
+		{
+			std::cerr << "ERROR | XGL::InstanceBuffer::set(size_t, const Mat4&) : Index out of range.\n";
+			throw OUT_OF_RANGE;
+		}
+		models[idx] = model;
+		markDirty(idx, idx + 1);
+	}
+
+	void InstanceBuffer::set(size_t idx, Vec3 position, const Quat& orientation, Vec3 scaling)
+	{
+		if (idx >= models.size())
+		{
+			std::cerr << "ERROR | XGL::InstanceBuffer::set(size_t, Vec3, const Quat&, Vec3) : Index out of range.\n";
+			throw OUT_OF_RANGE;
+		}
+		Transform::compose(models[idx], position, orientation, scaling);
+		markDirty(idx, idx + 1);
+	}
+
+	const Mat4& InstanceBuffer::get(size_t idx)
+	{
+		if (idx >= models.size())
+		{
+			std::cerr << "ERROR | XGL::InstanceBuffer::get(size_t) : Index out of range.\n";
+			throw OUT_OF_RANGE;
+		}
+		return models[idx];
+	}
+
+	void InstanceBuffer::setFirst(size_t first)
+	{
+		GLState::bindBuffer(GL_ARRAY_BUFFER, handle);
+		for (unsigned int i = 0; i < 4; i++)
+			glVertexAttribPointer(index + i, 4, GL_FLOAT, false, sizeof(Mat4), (void*)((first * 16 + i * 4) * sizeof(float)));
+	}
+
+	void InstanceBuffer::attach(Buffer& buffer)
+	{
+		if (buffer.getAttributeBuffer(index) == handle)
+			return;
+		// one vec4 attribute per column, Mat4 is column major
+		std::vector<Buffer::FormatDetail> format;
+		for (unsigned int i = 0; i < 4; i++)
+			format.push_back({ index + i, 4, GL_FLOAT, false, sizeof(Mat4), i * 4 * sizeof(float), 1 });
+		buffer.attachData(handle, format);
+	}
+
+	void InstanceBuffer::upload()
+	{
+		GLState::bindBuffer(GL_ARRAY_BUFFER, handle);
+		if (models.size() > capacity)
+		{
+			capacity = models.size() * 2;
+			glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(Mat4), NULL, GL_DYNAMIC_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0, models.size() * sizeof(Mat4), models.data());
+		}
+		else if (dirtyBegin < dirtyEnd)
+		{
+			size_t end = dirtyEnd < models.size() ? dirtyEnd : models.size();
+			if (dirtyBegin < end)
+				glBufferSubData(GL_ARRAY_BUFFER, dirtyBegin * sizeof(Mat4), (end - dirtyBegin) * sizeof(Mat4), models.data() + dirtyBegin);
+		}
+		dirtyBegin = dirtyEnd = 0;
+	}
+}
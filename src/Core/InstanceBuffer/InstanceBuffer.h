@@ -0,0 +1,61 @@
+#ifndef XGL_INSTANCEBUFFER_H
+#define XGL_INSTANCEBUFFER_H
+
+#include <Math/Vector.h>
+#include <Math/Matrix.h>
+#include <Math/Quaternion.h>
+#include "Object/Object.h"
+#include <glad/glad.h>
+
+#include <vector>
+
+namespace XGL
+{
+	// Per-instance model matrices for Program::drawInstanced(), fed to the vertex shader as a divisor 1 mat4
+	// attribute at locations index .. index + 3. Only the instances changed since the last upload() are streamed.
+	class InstanceBuffer
+	{
+		public:
+			enum ERROR { OUT_OF_RANGE };
+
+		private:
+			unsigned int handle;
+			unsigned int index;
+
+			std::vector<Mat4> models;
+			size_t capacity;	// instances the GL storage holds
+			size_t dirtyBegin;
+			size_t dirtyEnd;
+
+			void markDirty(size_t begin, size_t end);
+
+		public:
+			InstanceBuffer(unsigned int index = 3);
+			InstanceBuffer(const InstanceBuffer&) = delete;
+			InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+			~InstanceBuffer();
+
+			size_t getSize() { return models.size(); }
+			void resize(size_t size);
+			void clear() { models.clear(); markDirty(0, 0); }
+
+			void add(const Mat4& model);
+			void add(Vec3 position, const Quat& orientation, Vec3 scaling);
+			void set(size_t idx, const Mat4& model);
+			void set(size_t idx, Vec3 position, const Quat& orientation, Vec3 scaling);
+			const Mat4& get(size_t idx);
+
+			// sets up the attributes in buffer's vertex array, nothing happens if they are already there
+			void attach(Buffer& buffer);
+			// sends the changed instances, the whole array when it outgrew the GL storage
+			void upload();
+			// makes instance 0 of the following draws read model first, in the bound vertex array;
+			// the stand-in for base instances where the driver has none
+			void setFirst(size_t first);
+
+			unsigned int getHandle() { return handle; }
+			unsigned int getIndex() { return index; }
+	};
+}
+
+#endif // !XGL_INSTANCEBUFFER_H
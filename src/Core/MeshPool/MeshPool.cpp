@@ -0,0 +1,145 @@
+#include "MeshPool.h"
+
+#include <iostream>
+
+namespace XGL
+{
+	MeshPool::MeshPool() :
+		buffer(NULL), meshDirty(true), commandsDirty(true)
+	{
+		glGenBuffers(1, &indirectHandle);
+	}
+
+	MeshPool::~MeshPool()
+	{
+		delete buffer;
+		GLState::forgetBuffer(indirectHandle);
+		glDeleteBuffers(1, &indirectHandle);
+	}
+
+	size_t MeshPool::add(const std::vector<Vec3>& positions, const std::vector<Vec3>& normals,
+		const std::vector<Vec2>& texcoords, const std::vector<unsigned int>& indices)
+	{
+		if ((normals.size() && normals.size() != positions.size()) ||
+			(texcoords.size() && texcoords.size() != positions.size()))
+		{
+			std::cerr << "ERROR | XGL::MeshPool::add(const std::vector<Vec3>&, const std::vector<Vec3>&, const std::vector<Vec2>&, const std::vector<unsigned int>&) : Model data mismatch.\n";
+			throw MODEL_DATA_MISMATCH;
+		}
+
+		Mesh mesh;
+		mesh.indexCount = (unsigned int)indices.size();
+		mesh.firstIndex = (unsigned int)this->indices.size();
+		mesh.baseVertex = (int)(vertices.size() / vertexSize);
+
+		for (size_t i = 0; i < positions.size(); i++)
+		{
+			const float* p = positions[i].getData();
+			vertices.insert(vertices.end(), p, p + 3);
+			if (normals.size())
+			{
+				const float* n = normals[i].getData();
+				vertices.insert(vertices.end(), n, n + 3);
+			}
+			else
+				vertices.insert(vertices.end(), 3, 0.0f);
+			if (texcoords.size())
+			{
+				const float* t = texcoords[i].getData();
+				vertices.insert(vertices.end(), t, t + 2);
+			}
+			else
+				vertices.insert(vertices.end(), 2, 0.0f);
+		}
+		this->indices.insert(this->indices.end(), indices.begin(), indices.end());
+
+		meshes.push_back(mesh);
+		meshDirty = true;
+		return meshes.size() - 1;
+	}
+
+	size_t MeshPool::add(const Object& object)
+	{
+		return add(object.getModelPositions(), object.getModelNormals(), object.getModelTexcoords(), object.getModelIndices());
+	}
+
+	void MeshPool::addDraw(size_t mesh, const Mat4& model)
+	{
+		if (mesh >= meshes.size())
+		{
+			std::cerr << "ERROR | XGL::MeshPool::addDraw(size_t, const Mat4&) : No such mesh.\n";
+			throw NO_SUCH_MESH;
+		}
+		commands.push_back({ meshes[mesh].indexCount, 1, meshes[mesh].firstIndex, meshes[mesh].baseVertex, (unsigned int)commands.size() });
+		models.add(model);
+		commandsDirty = true;
+	}
+
+	void MeshPool::clearDraws()
+	{
+		commands.clear();
+		models.clear();
+		commandsDirty = true;
+	}
+
+	void MeshPool::addTexture(Texture& tex, const char* name, unsigned int unit)
+	{
+		if (!tex.isGenerated())
+			tex.generate();
+		textures.push_back({ &tex, name, unit, 0, -1 });
+	}
+
+	Buffer* MeshPool::getBuffer()
+	{
+		// rebuilt as a whole, meshes are expected to be added up front rather than every frame
+		if (meshDirty || !buffer)
+		{
+			std::vector<Buffer::FormatDetail> format = {
+				{ 0, 3, GL_FLOAT, false, vertexSize * sizeof(float), 0, 0 },
+				{ 1, 3, GL_FLOAT, false, vertexSize * sizeof(float), 3 * sizeof(float), 0 },
+				{ 2, 2, GL_FLOAT, false, vertexSize * sizeof(float), 6 * sizeof(float), 0 } };
+			Buffer* res = new Buffer();
+			res->addData(vertices.data(), vertices.size() * sizeof(float), Buffer::STATIC, format);
+			res->addIndex(indices.data(), indices.size() * sizeof(unsigned int), Buffer::STATIC);
+			delete buffer;
+			buffer = res;
+			meshDirty = false;
+		}
+		return buffer;
+	}
+
+	void MeshPool::draw()
+	{
+		if (commands.empty())
+			return;
+
+		Buffer* buffer = getBuffer();
+		models.attach(*buffer);
+		models.upload();
+		buffer->bind();
+
+		if (GLState::hasMultiDrawIndirect())
+		{
+			GLState::bindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectHandle);
+			if (commandsDirty)
+			{
+				glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawCommand), commands.data(), GL_DYNAMIC_DRAW);
+				commandsDirty = false;
+			}
+			GLState::multiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, NULL, (int)commands.size(), 0);
+			return;
+		}
+
+		// the base instance is emulated by pointing the attribute at the first model of each run
+		for (size_t first = 0, last; first < commands.size(); first = last)
+		{
+			for (last = first + 1; last < commands.size(); last++)
+				if (commands[last].firstIndex != commands[first].firstIndex || commands[last].count != commands[first].count)
+					break;
+			models.setFirst(first);
+			glDrawElementsInstancedBaseVertex(GL_TRIANGLES, commands[first].count, GL_UNSIGNED_INT,
+				(void*)(commands[first].firstIndex * sizeof(unsigned int)), (int)(last - first), commands[first].baseVertex);
+		}
+		models.setFirst(0);
+	}
+}
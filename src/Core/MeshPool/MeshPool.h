@@ -0,0 +1,85 @@
+#ifndef XGL_MESHPOOL_H
+#define XGL_MESHPOOL_H
+
+#include <Math/Vector.h>
+#include <Math/Matrix.h>
+#include "Object/Object.h"
+#include "InstanceBuffer/InstanceBuffer.h"
+#include <glad/glad.h>
+
+#include <vector>
+
+namespace XGL
+{
+	// Many meshes suballocated from one vertex and one index buffer sharing the Object layout
+	// ( position at 0, normal at 1, texcoord at 2 ), drawn as a batch through Program::drawPool().
+	// Each draw of the batch takes its model matrix from an instance attribute at locations 3 .. 6, as with
+	// InstanceBuffer, selected through the base instance of its indirect command.
+	class MeshPool
+	{
+		public:
+			enum ERROR { NO_SUCH_MESH, MODEL_DATA_MISMATCH };
+
+		private:
+			typedef struct
+			{
+				unsigned int indexCount;
+				unsigned int firstIndex;
+				int baseVertex;
+			} Mesh;
+
+			// layout fixed by glMultiDrawElementsIndirect
+			typedef struct
+			{
+				unsigned int count;
+				unsigned int instanceCount;
+				unsigned int firstIndex;
+				int baseVertex;
+				unsigned int baseInstance;
+			} DrawCommand;
+
+			// --- meshes, uploaded to buffer when it is next needed ---
+			std::vector<float> vertices;
+			std::vector<unsigned int> indices;
+			std::vector<Mesh> meshes;
+			Buffer* buffer;
+			bool meshDirty;
+
+			// --- batch ---
+			std::vector<DrawCommand> commands;
+			InstanceBuffer models;
+			unsigned int indirectHandle;
+			bool commandsDirty;
+
+			std::vector<Object::textureInfo> textures;
+
+			static const size_t vertexSize = 8;
+
+			Buffer* getBuffer();
+
+		public:
+			MeshPool();
+			MeshPool(const MeshPool&) = delete;
+			MeshPool& operator=(const MeshPool&) = delete;
+			~MeshPool();
+
+			// returns the mesh id; normals and texcoords may be empty, they are then zero
+			size_t add(const std::vector<Vec3>& positions, const std::vector<Vec3>& normals,
+				const std::vector<Vec2>& texcoords, const std::vector<unsigned int>& indices);
+			size_t add(const Object& object);
+			size_t getMeshNum() { return meshes.size(); }
+
+			void addDraw(size_t mesh, const Mat4& model);
+			void clearDraws();
+			size_t getDrawNum() { return commands.size(); }
+
+			void addTexture(Texture& tex, const char* name, unsigned int unit);
+			std::vector<Object::textureInfo>& getTextures() { return textures; }
+
+			// the whole batch in one glMultiDrawElementsIndirect; without it, one instanced draw per run of
+			// consecutive draws of the same mesh
+			void draw();
+	};
+}
+
+#endif // !XGL_MESHPOOL_H
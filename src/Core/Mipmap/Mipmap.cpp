@@ -0,0 +1,277 @@
+#include "Mipmap.h"
+#include "ThreadPool/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace XGL
+{
+	namespace
+	{
+		const float pi = 3.14159265358979f;
+
+		float srgbToLinear(float v)
+		{
+			return v <= 0.04045f ? v / 12.92f : powf((v + 0.055f) / 1.055f, 2.4f);
+		}
+
+		float linearToSrgb(float v)
+		{
+			return v <= 0.0031308f ? v * 12.92f : 1.055f * powf(v, 1 / 2.4f) - 0.055f;
+		}
+
+		// channels of a texel that carry color, alpha being the last of 2 or 4
+		int colorChannels(int channel)
+		{
+			return channel == 2 || channel == 4 ? channel - 1 : channel;
+		}
+
+		// --- conversion from and to normalized floats ---
+		void loadRow(const unsigned char* src, size_t count, int channel, bool sRGB, float* res)
+		{
+			static const struct Table
+			{
+				float linear[256];
+				float decoded[256];
+				Table()
+				{
+					for (int i = 0; i < 256; i++)
+					{
+						linear[i] = i / 255.0f;
+						decoded[i] = srgbToLinear(i / 255.0f);
+					}
+				}
+			} table;
+			int color = sRGB ? colorChannels(channel) : 0;
+			for (size_t i = 0; i < count; i += channel)
+				for (int c = 0; c < channel; c++)
+					res[i + c] = c < color ? table.decoded[src[i + c]] : table.linear[src[i + c]];
+		}
+
+		void loadRow(const unsigned short* src, size_t count, int channel, bool sRGB, float* res)
+		{
+			int color = sRGB ? colorChannels(channel) : 0;
+			for (size_t i = 0; i < count; i += channel)
+				for (int c = 0; c < channel; c++)
+					res[i + c] = c < color ? srgbToLinear(src[i + c] / 65535.0f) : src[i + c] / 65535.0f;
+		}
+
+		void loadRow(const float* src, size_t count, int, bool, float* res)
+		{
+			for (size_t i = 0; i < count; i++)
+				res[i] = src[i];
+		}
+
+		void storeRow(const float* src, size_t count, int channel, bool sRGB, unsigned char* res)
+		{
+			int color = sRGB ? colorChannels(channel) : 0;
+			for (size_t i = 0; i < count; i += channel)
+				for (int c = 0; c < channel; c++)
+				{
+					float v = src[i + c] < 0 ? 0 : src[i + c] > 1 ? 1 : src[i + c];
+					res[i + c] = (unsigned char)((c < color ? linearToSrgb(v) : v) * 255 + 0.5f);
+				}
+		}
+
+		void storeRow(const float* src, size_t count, int channel, bool sRGB, unsigned short* res)
+		{
+			int color = sRGB ? colorChannels(channel) : 0;
+			for (size_t i = 0; i < count; i += channel)
+				for (int c = 0; c < channel; c++)
+				{
+					float v = src[i + c] < 0 ? 0 : src[i + c] > 1 ? 1 : src[i + c];
+					res[i + c] = (unsigned short)((c < color ? linearToSrgb(v) : v) * 65535 + 0.5f);
+				}
+		}
+
+		void storeRow(const float* src, size_t count, int, bool, float* res)
+		{
+			for (size_t i = 0; i < count; i++)
+				res[i] = src[i] < 0 ? 0 : src[i];
+		}
+
+		// zeroth order modified Bessel function of the first kind, for the Kaiser window
+		float besselI0(float x)
+		{
+			float sum = 1, term = 1;
+			for (int k = 1; k < 16; k++)
+			{
+				term *= (x / (2 * k)) * (x / (2 * k));
+				sum += term;
+			}
+			return sum;
+		}
+
+		float sinc(float x)
+		{
+			return x == 0 ? 1 : sinf(pi * x) / (pi * x);
+		}
+	}
+
+	float Mipmap::weight(Filter filter, float x)
+	{
+		if (x <= -lobes || x >= lobes)
+			return 0;
+		if (filter == LANCZOS)
+			return sinc(x) * sinc(x / lobes);
+		// Kaiser window with alpha = 4, a sharper cut-off than Lanczos at the cost of a little more ringing
+		float t = x / lobes;
+		return sinc(x) * besselI0(4 * sqrtf(1 - t * t)) / besselI0(4);
+	}
+
+	void Mipmap::buildTaps(int srcSize, int dstSize, Filter filter, std::vector<Taps>& taps, std::vector<float>& weights)
+	{
+		float scale = (float)srcSize / dstSize;
+		taps.resize(dstSize);
+		std::vector<float> row(srcSize);
+		for (int x = 0; x < dstSize; x++)
+		{
+			// the destination texel covers [x, x + 1) * scale of the source
+			float begin = x * scale, end = (x + 1) * scale, center = (begin + end) / 2;
+			int first, last;
+			if (filter == BOX)
+			{
+				first = (int)floorf(begin);
+				last = (int)ceilf(end) - 1;
+			}
+			else
+			{
+				first = (int)ceilf(center - 0.5f - lobes * scale);
+				last = (int)floorf(center - 0.5f + lobes * scale);
+			}
+
+			// taps past the border are folded onto the edge texel
+			int lo = first < 0 ? 0 : first >= srcSize ? srcSize - 1 : first;
+			int hi = last < 0 ? 0 : last >= srcSize ? srcSize - 1 : last;
+			for (int i = lo; i <= hi; i++)
+				row[i] = 0;
+			float sum = 0;
+			for (int i = first; i <= last; i++)
+			{
+				float w = filter == BOX
+					? (end < i + 1 ? end : i + 1) - (begin > i ? begin : i)
+					: weight(filter, (i + 0.5f - center) / scale);
+				row[i < lo ? lo : i > hi ? hi : i] += w;
+				sum += w;
+			}
+
+			taps[x].first = lo;
+			taps[x].count = hi - lo + 1;
+			taps[x].offset = weights.size();
+			for (int i = lo; i <= hi; i++)
+				weights.push_back(row[i] / sum);
+		}
+	}
+
+	template<typename T>
+	void Mipmap::reduceRows(const T* src, int width, int channel, T* dst, bool sRGB,
+		const std::vector<Taps>& tapsX, const std::vector<Taps>& tapsY, const std::vector<float>& weights, int rowBegin, int rowEnd)
+	{
+		int dstWidth = (int)tapsX.size();
+		size_t srcRow = (size_t)width * channel, dstRow = (size_t)dstWidth * channel;
+		std::vector<float> texels(srcRow), column(dstRow);
+		std::vector<float> rows;
+		// resampled source rows rowFirst onwards, kept while the destination rows still reach them
+		int rowFirst = 0, rowCount = 0;
+
+		for (int y = rowBegin; y < rowEnd; y++)
+		{
+			const Taps& ty = tapsY[y];
+			if (ty.first != rowFirst || ty.count != rowCount)
+			{
+				// rows shared with the previous destination row are moved to the front rather than resampled again
+				int keep = 0;
+				if (rowCount && ty.first >= rowFirst)
+				{
+					keep = rowFirst + rowCount - ty.first;
+					keep = keep < 0 ? 0 : keep > ty.count ? ty.count : keep;
+				}
+				if (keep)
+					std::copy(rows.begin() + (ty.first - rowFirst) * dstRow, rows.begin() + (ty.first - rowFirst + keep) * dstRow, rows.begin());
+				if (rows.size() < ty.count * dstRow)
+					rows.resize(ty.count * dstRow);
+				for (int r = keep; r < ty.count; r++)
+				{
+					loadRow(src + (size_t)(ty.first + r) * srcRow, srcRow, channel, sRGB, texels.data());
+					float* out = rows.data() + r * dstRow;
+					for (int x = 0; x < dstWidth; x++)
+					{
+						const Taps& tx = tapsX[x];
+						const float* w = weights.data() + tx.offset;
+						const float* in = texels.data() + (size_t)tx.first * channel;
+#ifdef XGL_SIMD_SSE
+						if (channel == 4)
+						{
+							__m128 sum = _mm_setzero_ps();
+							for (int k = 0; k < tx.count; k++)
+								sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(in + 4 * k)));
+							_mm_storeu_ps(out + 4 * x, sum);
+							continue;
+						}
+#endif
+						for (int c = 0; c < channel; c++)
+						{
+							float sum = 0;
+							for (int k = 0; k < tx.count; k++)
+								sum += w[k] * in[k * channel + c];
+							out[x * channel + c] = sum;
+						}
+					}
+				}
+				rowFirst = ty.first;
+				rowCount = ty.count;
+			}
+
+			const float* w = weights.data() + ty.offset;
+			std::fill(column.begin(), column.end(), 0.0f);
+			for (int k = 0; k < ty.count; k++)
+			{
+				const float* in = rows.data() + (ty.first - rowFirst + k) * dstRow;
+#ifdef XGL_SIMD_SSE
+				SIMD::arrayScaleAdd(in, w[k], column.data(), dstRow);
+#else
+				for (size_t i = 0; i < dstRow; i++)
+					column[i] += in[i] * w[k];
+#endif
+			}
+			storeRow(column.data(), dstRow, channel, sRGB, dst + (size_t)y * dstRow);
+		}
+	}
+
+	template<typename T>
+	void Mipmap::reduce(const T* src, int width, int height, int channel, T* dst, Filter filter, bool sRGB, bool parallel)
+	{
+		int dstWidth = getLevelSize(width), dstHeight = getLevelSize(height);
+		std::vector<Taps> tapsX, tapsY;
+		std::vector<float> weights;
+		buildTaps(width, dstWidth, filter, tapsX, weights);
+		buildTaps(height, dstHeight, filter, tapsY, weights);
+
+		if (!parallel)
+		{
+			reduceRows(src, width, channel, dst, sRGB, tapsX, tapsY, weights, 0, dstHeight);
+			return;
+		}
+		ThreadPool::global().parallelFor(0, dstHeight, minParallelRows, [&](int rowBegin, int rowEnd)
+		{
+			reduceRows(src, width, channel, dst, sRGB, tapsX, tapsY, weights, rowBegin, rowEnd);
+		});
+	}
+
+	void Mipmap::downsample(const unsigned char* src, int width, int height, int channel, unsigned char* dst,
+		Filter filter, bool sRGB, bool parallel)
+	{
+		reduce(src, width, height, channel, dst, filter, sRGB, parallel);
+	}
+
+	void Mipmap::downsample(const unsigned short* src, int width, int height, int channel, unsigned short* dst,
+		Filter filter, bool sRGB, bool parallel)
+	{
+		reduce(src, width, height, channel, dst, filter, sRGB, parallel);
+	}
+
+	void Mipmap::downsample(const float* src, int width, int height, int channel, float* dst, Filter filter, bool parallel)
+	{
+		reduce(src, width, height, channel, dst, filter, false, parallel);
+	}
+}
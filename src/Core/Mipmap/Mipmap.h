@@ -0,0 +1,56 @@
+#ifndef XGL_MIPMAP_H
+#define XGL_MIPMAP_H
+
+#include <Math/SIMD.h>
+#include <cstddef>
+#include <vector>
+
+namespace XGL
+{
+	// CPU reduction of an image to its next mip level, max(1, width / 2) by max(1, height / 2) texels.
+	// The filter is separable: source rows are resampled into float rows, which are then accumulated column-wise
+	// into the destination. With sRGB set the color channels are averaged in linear light, alpha ( the last of
+	// 2 or 4 channels ) is always taken as linear. No GL is involved, loaders may call it from any thread.
+	class Mipmap
+	{
+		public:
+			enum Filter { BOX, LANCZOS, KAISER };
+
+			// destination rows handled by one job, fewer rows in total are reduced on the calling thread
+			static const int minParallelRows = 32;
+
+		private:
+			// source texels contributing to one destination texel along one axis, already clamped to the image
+			typedef struct
+			{
+				int first;
+				int count;
+				size_t offset;	// of the first weight in the weight table
+			} Taps;
+
+			// sinc lobes on each side for LANCZOS and KAISER, in destination texels
+			static const int lobes = 3;
+
+			static float weight(Filter filter, float x);
+			static void buildTaps(int srcSize, int dstSize, Filter filter, std::vector<Taps>& taps, std::vector<float>& weights);
+			template<typename T>
+			static void reduceRows(const T* src, int width, int channel, T* dst, bool sRGB,
+				const std::vector<Taps>& tapsX, const std::vector<Taps>& tapsY, const std::vector<float>& weights, int rowBegin, int rowEnd);
+			template<typename T>
+			static void reduce(const T* src, int width, int height, int channel, T* dst, Filter filter, bool sRGB, bool parallel);
+
+		public:
+			static int getLevelSize(int size) { return size / 2 > 0 ? size / 2 : 1; }
+
+			// parallel splits the rows across ThreadPool::global(), it must stay false on the pool's own workers
+			static void downsample(const unsigned char* src, int width, int height, int channel, unsigned char* dst,
+				Filter filter = BOX, bool sRGB = false, bool parallel = true);
+			static void downsample(const unsigned short* src, int width, int height, int channel, unsigned short* dst,
+				Filter filter = BOX, bool sRGB = false, bool parallel = true);
+			// float texels are linear and never negative, ringing below zero is clamped
+			static void downsample(const float* src, int width, int height, int channel, float* dst,
+				Filter filter = BOX, bool parallel = true);
+	};
+}
+
+#endif // !XGL_MIPMAP_H
@@ -5,12 +5,17 @@ namespace XGL
 	Buffer::~Buffer()
 	{
 		for (size_t i = 0; i < VBOHandle.size(); i++)
+		{
+			GLState::forgetBuffer(VBOHandle[i]);
 			glDeleteBuffers(1, &VBOHandle[i]);
+		}
+		GLState::forgetBuffer(EBOHandle);
 		glDeleteBuffers(1, &EBOHandle);
+		GLState::forgetVertexArray(VAOHandle);
 		glDeleteVertexArrays(1, &VAOHandle);
 	}
 
-	bool Buffer::addFormat(FormatDetail format)
+	bool Buffer::addFormat(FormatDetail format, unsigned int VBO)
 	{
 		auto itr = this->format.begin();
 		for (; itr < this->format.end(); itr++)
@@ -20,10 +25,32 @@ namespace XGL
 			else if (format.index < itr->index)
 				break;
 		}
+		formatBuffer.insert(formatBuffer.begin() + (itr - this->format.begin()), VBO);
 		this->format.insert(itr, format);
 		return true;
 	}
 
+	void Buffer::setAttributes(const std::vector<FormatDetail>& format)
+	{
+		for (size_t i = 0; i < format.size(); i++)
+		{
+			glVertexAttribPointer(
+				format[i].index, format[i].size, format[i].type,
+				format[i].normalized, format[i].structSize, (void*)format[i].offset);
+			if (format[i].divisor)
+				glVertexAttribDivisor(format[i].index, format[i].divisor);
+			glEnableVertexAttribArray(format[i].index);
+		}
+	}
+
+	unsigned int Buffer::getAttributeBuffer(unsigned int index)
+	{
+		for (size_t i = 0; i < format.size(); i++)
+			if (format[i].index == index)
+				return formatBuffer[i];
+		return 0;
+	}
+
 	size_t Buffer::getTypeSize(Type type)
 	{
 		switch (type)
@@ -96,15 +123,16 @@ namespace XGL
 				getTypeGL(format[i].type),
 				format[i].normalized,
 				elemOffset[format.size()],
-				elemOffset[i] }))
+				elemOffset[i],
+				0 }, VBO))
 			{
 				std::cerr << "ERROR | XGL::Buffer::addData(void*, size_t, Usage, std::vector<Format>) : Index collision.\n";
 				throw INDEX_COLLISION;
 			}
 		}
 
-		glBindVertexArray(VAOHandle);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		GLState::bindVertexArray(VAOHandle);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, VBO);
 		switch (usage)
 		{
 			case STREAM:
@@ -123,12 +151,10 @@ namespace XGL
 			glEnableVertexAttribArray(format[i].index);
 		}
 
-		glBindVertexArray(0);
-
 		delete[] elemOffset;
 	}
 
-	void Buffer::addData(void* data, size_t size, Usage usage, std::vector<FormatDetail> format)
+	unsigned int Buffer::addData(void* data, size_t size, Usage usage, std::vector<FormatDetail> format)
 	{
 		unsigned int VBO;
 		glGenBuffers(1, &VBO);
@@ -136,15 +162,15 @@ namespace XGL
 
 		for (size_t i = 0; i < format.size(); i++)
 		{
-			if (!addFormat(format[i]))
+			if (!addFormat(format[i], VBO))
 			{
 				std::cerr << "ERROR | XGL::Buffer::addData(void*, size_t, Usage, std::vector<FormatDetail>) : Index collision.\n";
 				throw INDEX_COLLISION;
 			}
 		}
 
-		glBindVertexArray(VAOHandle);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		GLState::bindVertexArray(VAOHandle);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, VBO);
 
 		switch (usage)
 		{
@@ -156,15 +182,24 @@ namespace XGL
 				glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW); break;
 		}
 
+		setAttributes(format);
+		return VBO;
+	}
+
+	void Buffer::attachData(unsigned int VBO, std::vector<FormatDetail> format)
+	{
 		for (size_t i = 0; i < format.size(); i++)
 		{
-			glVertexAttribPointer(
-				format[i].index, format[i].size, format[i].type,
-				format[i].normalized, format[i].structSize, (void*)format[i].offset);
-			glEnableVertexAttribArray(format[i].index);
+			if (!addFormat(format[i], VBO))
+			{
+				std::cerr << "ERROR | XGL::Buffer::attachData(unsigned int, std::vector<FormatDetail>) : Index collision.\n";
+				throw INDEX_COLLISION;
+			}
 		}
 
-		glBindVertexArray(0);
+		GLState::bindVertexArray(VAOHandle);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, VBO);
+		setAttributes(format);
 	}
 
 	void Buffer::addIndex(unsigned int* indices, size_t size, Usage usage)
@@ -175,9 +210,9 @@ namespace XGL
 			throw INDICES_EXISTED;
 		}
 
-		glBindVertexArray(VAOHandle);
+		GLState::bindVertexArray(VAOHandle);
 		glGenBuffers(1, &EBOHandle);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBOHandle);
+		GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBOHandle);
 
 		switch (usage)
 		{
@@ -188,15 +223,16 @@ namespace XGL
 			case DYNAMIC:
 				glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_DYNAMIC_DRAW); break;
 		}
-
-		glBindVertexArray(0);
 	}
 
 	Mat4& Object::modelMat()
 	{
-		model = rotateMat;
-		Transform::scale(model, scaleX, scaleY, scaleZ);
-		Transform::translate(model, position);
+		// rebuilt only after a setter has touched the pose
+		if (modelDirty)
+		{
+			Transform::compose(model, position, orientation, Vec3(scaleX, scaleY, scaleZ));
+			modelDirty = false;
+		}
 		return model;
 	}
 
@@ -204,7 +240,7 @@ namespace XGL
 	{ 
 		if (!tex.isGenerated())
 			tex.generate();
-		textures.push_back({ &tex, name, unit });
+		textures.push_back({ &tex, name, unit, 0, -1 });
 	}
 
 	void Object::addTexture(Texture& tex, const char* name)
@@ -258,14 +294,14 @@ namespace XGL
 		char* VBOData = new char[VBOSize];
 		size_t offset = 0;
 
-		format.push_back({0, 3, GL_FLOAT, false, vertexSize, offset});
+		format.push_back({0, 3, GL_FLOAT, false, vertexSize, offset, 0});
 		for (size_t i = 0; i < modelData.positions.size(); i++)
 			memcpy(VBOData + vertexSize * i + offset, modelData.positions[i].getData(), 3 * sizeof(float));
 		offset += 3 * sizeof(float);
 
 		if (modelData.normals.size())
 		{
-			format.push_back({ 1, 3, GL_FLOAT, true, vertexSize, offset });
+			format.push_back({ 1, 3, GL_FLOAT, true, vertexSize, offset, 0 });
 			for (size_t i = 0; i < modelData.positions.size(); i++)
 				memcpy(VBOData + vertexSize * i + offset, modelData.normals[i].getData(), 3 * sizeof(float));
 			offset += 3 * sizeof(float);
@@ -273,7 +309,7 @@ namespace XGL
 
 		if (modelData.texcoords.size())
 		{
-			format.push_back({ 2, 2, GL_FLOAT, false, vertexSize, offset });
+			format.push_back({ 2, 2, GL_FLOAT, false, vertexSize, offset, 0 });
 			for (size_t i = 0; i < modelData.positions.size(); i++)
 				memcpy(VBOData + vertexSize * i + offset, modelData.texcoords[i].getData(), 2 * sizeof(float));
 		}
@@ -290,4 +326,16 @@ namespace XGL
 		delete[] EBOData;
 		return res;
 	}
+
+	Buffer* Object::getBuffer()
+	{
+		if (meshDirty || !buffer)
+		{
+			Buffer* res = genBuffer();
+			delete buffer;
+			buffer = res;
+			meshDirty = false;
+		}
+		return buffer;
+	}
 }
@@ -4,7 +4,9 @@
 #include <Math/Vector.h>
 #include <Math/Matrix.h>
 #include <Math/Transform.h>
+#include <Math/Quaternion.h>
 #include "Texture/Texture.h"
+#include "GLState/GLState.h"
 #include <glad/glad.h>
 
 #include <vector>
@@ -34,6 +36,7 @@ namespace XGL
 				bool normalized;
 				size_t structSize;
 				size_t offset;
+				unsigned int divisor;	// 0 advances per vertex, n per n instances
 			} FormatDetail;
 
 		private:
@@ -43,23 +46,32 @@ namespace XGL
 			unsigned int EBOHandle;
 
 			std::vector<FormatDetail> format;
+			std::vector<unsigned int> formatBuffer;	// the VBO behind each entry of format
 
-			bool addFormat(FormatDetail format);
+			bool addFormat(FormatDetail format, unsigned int VBO);
+			void setAttributes(const std::vector<FormatDetail>& format);
 
 			size_t getTypeSize(Type type);
 			GLenum getTypeGL(Type type);
 
 		public:
 			Buffer() : EBOHandle(0) { glGenVertexArrays(1, &VAOHandle); }
+			Buffer(const Buffer&) = delete;
+			Buffer& operator=(const Buffer&) = delete;
 			~Buffer();
 
 			void addData(void* data, size_t size, Usage usage, std::vector<Format> format);
-			void addData(void* data, size_t size, Usage usage, std::vector<FormatDetail> format);
+			// returns the new VBO, which the Buffer owns
+			unsigned int addData(void* data, size_t size, Usage usage, std::vector<FormatDetail> format);
+			// sources attributes from a VBO the caller owns and keeps alive
+			void attachData(unsigned int VBO, std::vector<FormatDetail> format);
 			void addIndex(unsigned int* indices, size_t size, Usage usage);
 
-			void bind() { glBindVertexArray(VAOHandle); }
+			void bind() { GLState::bindVertexArray(VAOHandle); }
 
 			unsigned int getHandle() { return VAOHandle; }
+			// the VBO feeding an attribute index, 0 if it is unused
+			unsigned int getAttributeBuffer(unsigned int index);
 	};
 
 	class Object
@@ -72,6 +84,9 @@ namespace XGL
 				Texture* texture;
 				const char* name;
 				unsigned int unit;
+				// location of the sampler in the program that drew the slot last, filled by Program::bindTextures()
+				mutable unsigned int samplerProgram;
+				mutable int samplerLocation;
 			} textureInfo;
 
 		private:
@@ -84,44 +99,63 @@ namespace XGL
 				std::vector<unsigned int> indices;
 			} modelData;
 
+			// --- gpu data, rebuilt lazily after the mesh changes ---
+			Buffer* buffer;
+			bool meshDirty;
+
 			// --- texture ---
 			std::vector<textureInfo> textures;
 
 			// --- world data ---
 			Vec3 position;
-			Mat4 rotateMat;
+			Quat orientation;
 			float scaleX, scaleY, scaleZ;
 			Mat4 model;
+			bool modelDirty;
 
 		public:
 			Object() :
-				rotateMat(Mat4::identity()),
-				scaleX(1), scaleY(1), scaleZ(1) {}
-			~Object() {}
-
-			void setModelPositions(std::vector<Vec3>& positions) { modelData.positions = positions; }
-			void setModelNormals(std::vector<Vec3>& normals) { modelData.normals = normals; }
-			void setModelTexcoords(std::vector<Vec2>& texcoords) { modelData.texcoords = texcoords; }
-			void setModelIndices(std::vector<unsigned int> indices) { modelData.indices = indices; }
-
-			void addModelPosition(Vec3 position) { modelData.positions.push_back(position); }
-			void addModelNormal(Vec3 normal) { modelData.normals.push_back(normal); }
-			void addModelTexcoord(Vec2 texcoord) { modelData.texcoords.push_back(texcoord); }
-			void addModelIndex(unsigned int index) { modelData.indices.push_back(index); }
-
-			void setPosition(Vec3 position) { this->position = position; }
-			void setRotation(float angle, Vec3 axis) { rotateMat = Transform::rotate(angle, axis); }
-			void setScaling(float x, float y, float z) { scaleX = x; scaleY = y; scaleZ = z; }
-			void setScaling(float f) { scaleX = f; scaleY = f; scaleZ = f; }
+				buffer(NULL), meshDirty(true),
+				scaleX(1), scaleY(1), scaleZ(1),
+				modelDirty(true) {}
+			// the cached Buffer owns GL objects and is not shared
+			Object(const Object&) = delete;
+			Object& operator=(const Object&) = delete;
+			~Object() { delete buffer; }
+
+			void setModelPositions(std::vector<Vec3>& positions) { modelData.positions = positions; meshDirty = true; }
+			void setModelNormals(std::vector<Vec3>& normals) { modelData.normals = normals; meshDirty = true; }
+			void setModelTexcoords(std::vector<Vec2>& texcoords) { modelData.texcoords = texcoords; meshDirty = true; }
+			void setModelIndices(std::vector<unsigned int> indices) { modelData.indices = indices; meshDirty = true; }
+
+			void addModelPosition(Vec3 position) { modelData.positions.push_back(position); meshDirty = true; }
+			void addModelNormal(Vec3 normal) { modelData.normals.push_back(normal); meshDirty = true; }
+			void addModelTexcoord(Vec2 texcoord) { modelData.texcoords.push_back(texcoord); meshDirty = true; }
+			void addModelIndex(unsigned int index) { modelData.indices.push_back(index); meshDirty = true; }
+
+			void setPosition(Vec3 position) { this->position = position; modelDirty = true; }
+			void setRotation(float angle, Vec3 axis) { orientation = Quat::fromAxisAngle(angle, axis); modelDirty = true; }
+			void setOrientation(const Quat& rotation) { orientation = rotation; modelDirty = true; }
+			void rotate(const Quat& rotation) { orientation = rotation * orientation; modelDirty = true; }
+			void setScaling(float x, float y, float z) { scaleX = x; scaleY = y; scaleZ = z; modelDirty = true; }
+			void setScaling(float f) { scaleX = f; scaleY = f; scaleZ = f; modelDirty = true; }
 			Mat4& modelMat();
+			const Quat& getOrientation() const { return orientation; }
 
 			void addTexture(Texture& tex, const char* name, unsigned int unit);
 			void addTexture(Texture& tex, const char* name);
 
 			size_t getVertexNum() { return modelData.indices.size(); }
+			const std::vector<Vec3>& getModelPositions() const { return modelData.positions; }
+			const std::vector<Vec3>& getModelNormals() const { return modelData.normals; }
+			const std::vector<Vec2>& getModelTexcoords() const { return modelData.texcoords; }
+			const std::vector<unsigned int>& getModelIndices() const { return modelData.indices; }
 			std::vector<textureInfo>& getTextures() { return textures; }
 
+			// a new Buffer owned by the caller
 			Buffer* genBuffer();
+			// the Object's own Buffer, regenerated only when the mesh has changed since the last call
+			Buffer* getBuffer();
 	};
 }
 
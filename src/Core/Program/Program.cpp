@@ -7,78 +7,92 @@ namespace XGL
 	template<>
 	Uniform<int>& Uniform<int>::operator= (const int& value)
 	{
-		glUseProgram(program);
-		glUniform1i(location, value);
-		glUseProgram(0);
+		GLState::programUniform1i(program, location, value);
 		return *this;
 	}
 
 	template<>
 	Uniform<float>& Uniform<float>::operator= (const float& value)
 	{
-		glUseProgram(program);
-		glUniform1f(location, value);
-		glUseProgram(0);
+		GLState::programUniform1f(program, location, value);
 		return *this;
 	}
 
 	template<>
 	Uniform<Vec2>& Uniform<Vec2>::operator= (const Vec2& value)
 	{
-		glUseProgram(program);
-		glUniform2fv(location, 1, value.getData());
-		glUseProgram(0);
+		GLState::programUniform2fv(program, location, value.getData());
 		return *this;
 	}
 
 	template<>
 	Uniform<Vec3>& Uniform<Vec3>::operator= (const Vec3& value)
 	{
-		glUseProgram(program);
-		value == Vec3(0,0,0);
-		glUniform3fv(location, 1, value.getData());
-		glUseProgram(0);
+		GLState::programUniform3fv(program, location, value.getData());
 		return *this;
 	}
 
 	template<>
 	Uniform<Vec4>& Uniform<Vec4>::operator= (const Vec4& value)
 	{
-		glUseProgram(program);
-		glUniform4fv(location, 1, value.getData());
-		glUseProgram(0);
+		GLState::programUniform4fv(program, location, value.getData());
 		return *this;
 	}
 
 	template<>
 	Uniform<Mat2>& Uniform<Mat2>::operator= (const Mat2& value)
 	{
-		glUseProgram(program);
-		glUniformMatrix2fv(location, 1, value.getMajor(), value.getData());
-		glUseProgram(0);
+		GLState::programUniformMatrix2fv(program, location, value.getMajor(), value.getData());
 		return *this;
 	}
 
 	template<>
 	Uniform<Mat3>& Uniform<Mat3>::operator= (const Mat3& value)
 	{
-		glUseProgram(program);
-		glUniformMatrix3fv(location, 1, value.getMajor(), value.getData());
-		glUseProgram(0);
+		GLState::programUniformMatrix3fv(program, location, value.getMajor(), value.getData());
 		return *this;
 	}
 
 	template<>
 	Uniform<Mat4>& Uniform<Mat4>::operator= (const Mat4& value)
 	{
-		glUseProgram(program);
-		glUniformMatrix4fv(location, 1, value.getMajor(), value.getData());
-		glUseProgram(0);
+		GLState::programUniformMatrix4fv(program, location, value.getMajor(), value.getData());
 		return *this;
 	}
 
+	template<>
+	bool Uniform<int>::matchType(unsigned int glType)
+	{
+		switch (glType)
+		{
+			case GL_INT: case GL_BOOL:
+			case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+			case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_2D_ARRAY:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	template<>
+	bool Uniform<float>::matchType(unsigned int glType) { return glType == GL_FLOAT; }
+	template<>
+	bool Uniform<Vec2>::matchType(unsigned int glType) { return glType == GL_FLOAT_VEC2; }
+	template<>
+	bool Uniform<Vec3>::matchType(unsigned int glType) { return glType == GL_FLOAT_VEC3; }
+	template<>
+	bool Uniform<Vec4>::matchType(unsigned int glType) { return glType == GL_FLOAT_VEC4; }
+	template<>
+	bool Uniform<Mat2>::matchType(unsigned int glType) { return glType == GL_FLOAT_MAT2; }
+	template<>
+	bool Uniform<Mat3>::matchType(unsigned int glType) { return glType == GL_FLOAT_MAT3; }
+	template<>
+	bool Uniform<Mat4>::matchType(unsigned int glType) { return glType == GL_FLOAT_MAT4; }
+
     // --- Program ---
 
+	unsigned int Program::nextSerial = 0;
+
     bool Program::linkOutput()
     {
         int success;
@@ -102,38 +116,160 @@ namespace XGL
 			throw NO_CAMERA;
 		}
 		camera->update(deltaT);
+		if (cameraBlock)
+			camera->publish();
+	}
+
+	void Program::enumerateUniforms()
+	{
+		uniforms.clear();
+		samplerUnits.clear();
+		int count, maxLength;
+		glGetProgramiv(handle, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+		char* name = new char[maxLength + 1];
+		for (int i = 0; i < count; i++)
+		{
+			int length, size;
+			unsigned int type;
+			glGetActiveUniform(handle, i, maxLength + 1, &length, &size, &type, name);
+			int location = glGetUniformLocation(handle, name);
+			// members of uniform blocks have no location
+			if (location == -1)
+				continue;
+			uniforms[std::string(name, length)] = UniformHandle(location, type);
+			if ((size_t)location >= samplerUnits.size())
+				samplerUnits.resize(location + 1, -1);
+			// arrays are reported as "name[0]", make them reachable as "name" too
+			if (length > 3 && !strcmp(name + length - 3, "[0]"))
+				uniforms[std::string(name, length - 3)] = UniformHandle(location, type);
+		}
+		delete[] name;
+
+		viewHandle = uniformHandle("view");
+		projectionHandle = uniformHandle("projection");
+		modelHandle = uniformHandle("model");
 	}
 
     void Program::link()
     {
         glLinkProgram(handle);
         linkOutput();
+		serial = ++nextSerial;
+		enumerateUniforms();
+		cameraBlock = bindUniformBlock("Camera", Camera::blockBinding);
     }
 
     void Program::use()
     {
-        glUseProgram(handle);
+        GLState::useProgram(handle);
     }
 
-	void Program::draw(Object& object)
+	bool Program::bindUniformBlock(const char* name, unsigned int binding)
+	{
+		unsigned int index = glGetUniformBlockIndex(handle, name);
+		if (index == GL_INVALID_INDEX)
+			return false;
+		glUniformBlockBinding(handle, index, binding);
+		return true;
+	}
+
+	UniformHandle Program::uniformHandle(const char* name)
+	{
+		auto it = uniforms.find(name);
+		if (it == uniforms.end())
+			return UniformHandle();
+		return it->second;
+	}
+
+	void Program::applyCamera()
 	{
-		uniform<Mat4>("view") = camera->viewMat();
-		uniform<Mat4>("projection") = camera->projectionMat();
-		uniform<Mat4>("model") = object.modelMat();
+		if (!camera)
+		{
+			std::cerr << "ERROR | XGL::Program::applyCamera() : Camera not set.\n";
+			throw NO_CAMERA;
+		}
+		// shared by every program using the block, nothing is uploaded or bound per draw once it is current
+		if (cameraBlock)
+		{
+			camera->publish();
+			return;
+		}
+		uniform<Mat4>(viewHandle) = camera->viewMat();
+		uniform<Mat4>(projectionHandle) = camera->projectionMat();
+	}
 
-		std::vector<Object::textureInfo> textures = object.getTextures();
+	void Program::bindTextures(const std::vector<Object::textureInfo>& textures)
+	{
 		for (size_t i = 0; i < textures.size(); i++)
 		{
-			textures[i].texture->bind(textures[i].unit);
-			uniform<int>(textures[i].name) = textures[i].unit;
+			const Object::textureInfo& slot = textures[i];
+			slot.texture->bind(slot.unit);
+			// the name is looked up once per slot and program, the slot then keeps the location
+			if (slot.samplerProgram != serial)
+			{
+				UniformHandle sampler = uniformHandle(slot.name);
+				if (!sampler.isValid())
+				{
+					std::cerr << "ERROR | XGL::Program::bindTextures(const std::vector<Object::textureInfo>&) : No such uniform \"" << slot.name << "\".\n";
+					throw NO_SUCH_UNIFORM;
+				}
+				if (!Uniform<int>::matchType(sampler.type))
+				{
+					std::cerr << "ERROR | XGL::Program::bindTextures(const std::vector<Object::textureInfo>&) : Uniform \"" << slot.name << "\" has a different type.\n";
+					throw TYPE_MISMATCH;
+				}
+				slot.samplerProgram = serial;
+				slot.samplerLocation = sampler.location;
+			}
+			// a sampler keeps its unit across draws, most objects of a program use the same layout
+			int unit = slot.unit;
+			if (samplerUnits[slot.samplerLocation] == unit)
+				continue;
+			GLState::programUniform1i(handle, slot.samplerLocation, unit);
+			samplerUnits[slot.samplerLocation] = unit;
 		}
+	}
+
+	void Program::drawBuffer(Buffer* buffer, size_t vertexNum, const Mat4& model, const std::vector<Object::textureInfo>& textures)
+	{
+		uniform<Mat4>(modelHandle) = model;
+		bindTextures(textures);
 
-		Buffer* buffer = object.genBuffer();
 		use();
 		buffer->bind();
-		glDrawElements(GL_TRIANGLES, object.getVertexNum(), GL_UNSIGNED_INT, NULL);
-		glBindVertexArray(0);
-		glUseProgram(0);
-		delete buffer;
+		glDrawElements(GL_TRIANGLES, vertexNum, GL_UNSIGNED_INT, NULL);
+	}
+
+	void Program::draw(Object& object)
+	{
+		applyCamera();
+		drawBuffer(object.getBuffer(), object.getVertexNum(), object.modelMat(), object.getTextures());
+	}
+
+	void Program::drawInstanced(Object& object, InstanceBuffer& instances)
+	{
+		if (!instances.getSize())
+			return;
+		applyCamera();
+		bindTextures(object.getTextures());
+
+		Buffer* buffer = object.getBuffer();
+		instances.attach(*buffer);
+		instances.upload();
+
+		use();
+		buffer->bind();
+		glDrawElementsInstanced(GL_TRIANGLES, object.getVertexNum(), GL_UNSIGNED_INT, NULL, instances.getSize());
+	}
+
+	void Program::drawPool(MeshPool& pool)
+	{
+		if (!pool.getDrawNum())
+			return;
+		applyCamera();
+		bindTextures(pool.getTextures());
+		use();
+		pool.draw();
 	}
 }
@@ -6,6 +6,12 @@
 #include <Math/Matrix.h>
 #include "Object/Object.h"
 #include "Camera/Camera.h"
+#include "GLState/GLState.h"
+#include "InstanceBuffer/InstanceBuffer.h"
+#include "MeshPool/MeshPool.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace XGL
 {
@@ -52,6 +58,9 @@ namespace XGL
 
 			Uniform<T>& operator= (const T& value);
 			Uniform<T>& operator= (T&& value) { (*this) = value; return *this; }
+
+			// whether a uniform of GLSL type glType can be set from a T
+			static bool matchType(unsigned int glType);
 	};
 
 	template<>
@@ -71,20 +80,73 @@ namespace XGL
 	template<>
 	Uniform<Mat4>& Uniform<Mat4>::operator= (const Mat4& value);
 
+	template<>
+	bool Uniform<int>::matchType(unsigned int glType);
+	template<>
+	bool Uniform<float>::matchType(unsigned int glType);
+	template<>
+	bool Uniform<Vec2>::matchType(unsigned int glType);
+	template<>
+	bool Uniform<Vec3>::matchType(unsigned int glType);
+	template<>
+	bool Uniform<Vec4>::matchType(unsigned int glType);
+	template<>
+	bool Uniform<Mat2>::matchType(unsigned int glType);
+	template<>
+	bool Uniform<Mat3>::matchType(unsigned int glType);
+	template<>
+	bool Uniform<Mat4>::matchType(unsigned int glType);
+
+	// A uniform resolved once by Program::uniformHandle(), setting it through the handle skips the name lookup.
+	class UniformHandle
+	{
+		friend class Program;
+
+		private:
+			int location;
+			unsigned int type;
+
+			UniformHandle(int location, unsigned int type) : location(location), type(type) {}
+
+		public:
+			UniformHandle() : location(-1), type(0) {}
+
+			bool isValid() const { return location != -1; }
+			int getLocation() const { return location; }
+			unsigned int getType() const { return type; }
+	};
+
 	class Program
 	{
 		public:
-			enum ERROR { NO_SUCH_UNIFORM, LINK_FAIL, NO_CAMERA };
+			enum ERROR { NO_SUCH_UNIFORM, LINK_FAIL, NO_CAMERA, TYPE_MISMATCH };
 
 		private:
 			unsigned int handle;
 			Camera* camera;
 
+			// active uniforms, filled once by link()
+			std::unordered_map<std::string, UniformHandle> uniforms;
+			UniformHandle viewHandle;
+			UniformHandle projectionHandle;
+			UniformHandle modelHandle;
+			bool cameraBlock;	// the program reads view and projection from the Camera block
+
+			// set by each link(), so texture slots can tell which program resolved their sampler
+			unsigned int serial;
+			static unsigned int nextSerial;
+			// unit last written by bindTextures() to each uniform location, -1 if unknown
+			std::vector<int> samplerUnits;
+
 			bool linkOutput();
+			void enumerateUniforms();
+			template<typename T>
+			void forgetSamplerUnit(int location);
+			void bindTextures(const std::vector<Object::textureInfo>& textures);
 
 		public:
-			Program() : handle(glCreateProgram()), camera(NULL) {}
-			~Program() { glDeleteProgram(handle); }
+			Program() : handle(glCreateProgram()), camera(NULL), cameraBlock(false), serial(0) {}
+			~Program() { GLState::forgetProgram(handle); glDeleteProgram(handle); }
 
 			void setCamera(Camera& camera) { this->camera = &camera; }
 			void updateCamera(float deltaT);
@@ -93,11 +155,27 @@ namespace XGL
 			void link();
 			void use();
 			void draw(Object& object);
+			// the two halves of draw(): view and projection from the camera, then one mesh with its model matrix and textures
+			void applyCamera();
+			void drawBuffer(Buffer* buffer, size_t vertexNum, const Mat4& model, const std::vector<Object::textureInfo>& textures);
+			// one draw call for every instance, the model matrix comes from the instance attribute instead of the uniform
+			void drawInstanced(Object& object, InstanceBuffer& instances);
+			// every draw queued in the pool, the model matrix again comes from the instance attribute
+			void drawPool(MeshPool& pool);
 
 			unsigned int getHandle() { return handle; }
+			Camera* getCamera() { return camera; }
+
+			// false if the linked program has no uniform block of that name
+			bool bindUniformBlock(const char* name, unsigned int binding);
+
+			// an invalid handle if the linked program has no active uniform of that name
+			UniformHandle uniformHandle(const char* name);
 
 			template<typename T>
 			Uniform<T> uniform(const char* name);
+			template<typename T>
+			Uniform<T> uniform(const UniformHandle& handle);
 	};
 }
 
@@ -5,6 +5,7 @@
 
 #include <fstream>
 #include <sstream>
+#include <type_traits>
 
 namespace XGL
 {
@@ -78,16 +79,47 @@ namespace XGL
 		glAttachShader(handle, shader.getHandle());
 	}
 
+	template<typename T>
+	void Program::forgetSamplerUnit(int location)
+	{
+		// the returned Uniform may write a sampler unit bindTextures() does not see
+		if (std::is_same<T, int>::value && location < (int)samplerUnits.size())
+			samplerUnits[location] = -1;
+	}
+
 	template<typename T>
 	Uniform<T> Program::uniform(const char* name)
 	{
-		int location = glGetUniformLocation(handle, name);
-		if (location == -1)
+		auto it = uniforms.find(name);
+		if (it == uniforms.end())
 		{
 			std::cerr << "ERROR | XGL::Program::uniform(const char*) : No such uniform.\n";
 			throw NO_SUCH_UNIFORM;
 		}
-		return Uniform<T>(handle, location);
+		if (!Uniform<T>::matchType(it->second.type))
+		{
+			std::cerr << "ERROR | XGL::Program::uniform(const char*) : Uniform \"" << name << "\" has a different type.\n";
+			throw TYPE_MISMATCH;
+		}
+		forgetSamplerUnit<T>(it->second.location);
+		return Uniform<T>(handle, it->second.location);
+	}
+
+	template<typename T>
+	Uniform<T> Program::uniform(const UniformHandle& handle)
+	{
+		if (!handle.isValid())
+		{
+			std::cerr << "ERROR | XGL::Program::uniform(const UniformHandle&) : No such uniform.\n";
+			throw NO_SUCH_UNIFORM;
+		}
+		if (!Uniform<T>::matchType(handle.type))
+		{
+			std::cerr << "ERROR | XGL::Program::uniform(const UniformHandle&) : Uniform has a different type.\n";
+			throw TYPE_MISMATCH;
+		}
+		forgetSamplerUnit<T>(handle.location);
+		return Uniform<T>(this->handle, handle.location);
 	}
 }
 
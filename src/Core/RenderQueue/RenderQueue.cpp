@@ -0,0 +1,153 @@
+#include "RenderQueue.h"
+
+#include <unordered_set>
+
+namespace XGL
+{
+	unsigned long long RenderQueue::field(unsigned int value, int bits)
+	{
+		// ids past the field width share its last value, which only costs ordering, never correctness
+		unsigned long long max = (1ull << bits) - 1;
+		return value < max ? value : max;
+	}
+
+	unsigned int RenderQueue::quantizeDepth(Program& program, const Mat4& model)
+	{
+		Camera* camera = program.getCamera();
+		if (!camera)
+			return 0;
+		// view space distance of the model origin, the camera looks down -z
+		Mat4& view = camera->viewMat();
+		float depth = -(view.elem(2, 0) * model.elem(0, 3) + view.elem(2, 1) * model.elem(1, 3)
+			+ view.elem(2, 2) * model.elem(2, 3) + view.elem(2, 3));
+		float range = camera->getFar();
+		if (depth <= 0)
+			return 0;
+		if (depth >= range)
+			return (1u << depthBits) - 1;
+		return (unsigned int)(depth / range * ((1u << depthBits) - 1));
+	}
+
+	void RenderQueue::submit(Program& program, Object& object, Pass pass)
+	{
+		Item item;
+		item.program = &program;
+		item.buffer = object.getBuffer();
+		item.vertexNum = object.getVertexNum();
+		item.textures = &object.getTextures();
+		item.model = object.modelMat();
+
+		item.programId = programIds.emplace(&program, (unsigned int)programIds.size()).first->second;
+		std::vector<unsigned int> textureSet;
+		for (size_t i = 0; i < item.textures->size(); i++)
+		{
+			textureSet.push_back((*item.textures)[i].unit);
+			textureSet.push_back((*item.textures)[i].texture->getHandle());
+		}
+		item.textureId = textureIds.emplace(textureSet, (unsigned int)textureIds.size()).first->second;
+		item.vertexArrayId = vertexArrayIds.emplace(item.buffer->getHandle(), (unsigned int)vertexArrayIds.size()).first->second;
+
+		unsigned long long depth = quantizeDepth(program, item.model);
+		unsigned long long state =
+			field(item.programId, programBits) << (textureBits + vertexArrayBits) |
+			field(item.textureId, textureBits) << vertexArrayBits |
+			field(item.vertexArrayId, vertexArrayBits);
+		if (pass == SOLID)
+			item.key = state << depthBits | depth;
+		else
+			item.key = 1ull << 63 | ((1ull << depthBits) - 1 - depth) << (programBits + textureBits + vertexArrayBits) | state;
+
+		items.push_back(item);
+	}
+
+	void RenderQueue::radixSort()
+	{
+		size_t n = items.size();
+		keys.resize(n);
+		order.resize(n);
+		std::vector<unsigned long long> keyTemp(n);
+		std::vector<unsigned int> orderTemp(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			keys[i] = items[i].key;
+			order[i] = (unsigned int)i;
+		}
+
+		// least significant byte first, stable, so earlier submissions win ties
+		for (int shift = 0; shift < 64; shift += 8)
+		{
+			size_t count[257] = {};
+			for (size_t i = 0; i < n; i++)
+				count[((keys[i] >> shift) & 0xff) + 1]++;
+			// all keys share this byte, the pass would not move anything
+			if (count[((keys[0] >> shift) & 0xff) + 1] == n)
+				continue;
+			for (int i = 0; i < 256; i++)
+				count[i + 1] += count[i];
+			for (size_t i = 0; i < n; i++)
+			{
+				size_t dst = count[(keys[i] >> shift) & 0xff]++;
+				keyTemp[dst] = keys[i];
+				orderTemp[dst] = order[i];
+			}
+			keys.swap(keyTemp);
+			order.swap(orderTemp);
+		}
+	}
+
+	RenderQueue::Statistics RenderQueue::countChanges(const unsigned int* order) const
+	{
+		Statistics res = { items.size(), 0, 0, 0, 0 };
+		const Item* last = NULL;
+		for (size_t i = 0; i < items.size(); i++)
+		{
+			const Item& item = items[order ? order[i] : i];
+			if (!last || item.programId != last->programId)
+				res.programChanges++;
+			if (!last || item.textureId != last->textureId)
+				res.textureChanges++;
+			if (!last || item.vertexArrayId != last->vertexArrayId)
+				res.vertexArrayChanges++;
+			last = &item;
+		}
+		return res;
+	}
+
+	void RenderQueue::flush()
+	{
+		if (items.empty())
+		{
+			statistics = { 0, 0, 0, 0, 0 };
+			return;
+		}
+
+		radixSort();
+
+		Statistics unsorted = countChanges(NULL);
+		statistics = countChanges(order.data());
+		size_t before = unsorted.programChanges + unsorted.textureChanges + unsorted.vertexArrayChanges;
+		size_t after = statistics.programChanges + statistics.textureChanges + statistics.vertexArrayChanges;
+		// back to front ordering of translucent items may cost more than it saves
+		statistics.savedChanges = before > after ? before - after : 0;
+
+		// view and projection are written once per program and frame
+		std::unordered_set<Program*> cameraApplied;
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			Item& item = items[order[i]];
+			if (cameraApplied.insert(item.program).second)
+				item.program->applyCamera();
+			item.program->drawBuffer(item.buffer, item.vertexNum, item.model, *item.textures);
+		}
+
+		clear();
+	}
+
+	void RenderQueue::clear()
+	{
+		items.clear();
+		programIds.clear();
+		textureIds.clear();
+		vertexArrayIds.clear();
+	}
+}
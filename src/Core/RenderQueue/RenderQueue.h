@@ -0,0 +1,86 @@
+#ifndef XGL_RENDERQUEUE_H
+#define XGL_RENDERQUEUE_H
+
+#include <Math/Matrix.h>
+#include "Object/Object.h"
+#include "Program/Program.h"
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+namespace XGL
+{
+	// Collects draws for a frame and submits them sorted by a 64 bit key, so that items sharing a program,
+	// texture set and vertex array are drawn back to back and GLState can drop the repeated binds.
+	// Opaque items go front to back within the same state, transparent ones strictly back to front.
+	// The model matrix is copied on submit; the Object's mesh, textures and the Program must outlive flush().
+	class RenderQueue
+	{
+		public:
+			enum Pass { SOLID, TRANSLUCENT };
+
+			typedef struct
+			{
+				size_t items;
+				// state changes in sorted order
+				size_t programChanges;
+				size_t textureChanges;
+				size_t vertexArrayChanges;
+				// state changes the submission order would have needed minus the ones issued
+				size_t savedChanges;
+			} Statistics;
+
+		private:
+			typedef struct
+			{
+				Program* program;
+				Buffer* buffer;
+				size_t vertexNum;
+				const std::vector<Object::textureInfo>* textures;
+				Mat4 model;
+				unsigned int programId;
+				unsigned int textureId;
+				unsigned int vertexArrayId;
+				unsigned long long key;
+			} Item;
+
+			// --- key layout, from the most significant bit ---
+			// SOLID:       pass(1) program(10) textures(12) vertex array(16) depth(24)
+			// TRANSLUCENT: pass(1) ~depth(24) program(10) textures(12) vertex array(16)
+			static const int programBits = 10;
+			static const int textureBits = 12;
+			static const int vertexArrayBits = 16;
+			static const int depthBits = 24;
+
+			std::vector<Item> items;
+			std::vector<unsigned long long> keys;
+			std::vector<unsigned int> order;
+
+			// dense per-frame ids, so the fields fit their bits
+			std::unordered_map<Program*, unsigned int> programIds;
+			std::map<std::vector<unsigned int>, unsigned int> textureIds;
+			std::unordered_map<unsigned int, unsigned int> vertexArrayIds;
+
+			Statistics statistics;
+
+			static unsigned long long field(unsigned int value, int bits);
+			static unsigned int quantizeDepth(Program& program, const Mat4& model);
+			void radixSort();
+			Statistics countChanges(const unsigned int* order) const;
+
+		public:
+			RenderQueue() : statistics({ 0, 0, 0, 0, 0 }) {}
+			~RenderQueue() {}
+
+			void submit(Program& program, Object& object, Pass pass = SOLID);
+			// sorts and draws everything submitted since the last flush, then empties the queue
+			void flush();
+			void clear();
+
+			size_t getSize() const { return items.size(); }
+			// counters of the last flush()
+			const Statistics& getStatistics() const { return statistics; }
+	};
+}
+
+#endif // !XGL_RENDERQUEUE_H
@@ -0,0 +1,114 @@
+#include "StreamingBuffer.h"
+
+#include <iostream>
+
+namespace XGL
+{
+	StreamingBuffer::StreamingBuffer(size_t regionSize) :
+		regionSize(regionSize), region(0), head(0), mapped(NULL), mappedBegin(0)
+	{
+		for (unsigned int i = 0; i < regionCount; i++)
+			fences[i] = NULL;
+
+		// GL_COPY_WRITE_BUFFER leaves the array and element bindings of the current vertex array alone
+		glGenBuffers(1, &handle);
+		GLState::bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+		persistent = GLState::hasBufferStorage();
+		if (persistent)
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			GLState::bufferStorage(GL_COPY_WRITE_BUFFER, regionCount * regionSize, NULL, flags);
+			mapped = (char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, regionCount * regionSize, flags);
+			if (!mapped)
+			{
+				std::cerr << "ERROR | XGL::StreamingBuffer::StreamingBuffer(size_t) : Failed to map buffer.\n";
+				throw MAP_FAIL;
+			}
+		}
+		else	// the first storage, endFrame() replaces it on each wrap
+			glBufferData(GL_COPY_WRITE_BUFFER, regionCount * regionSize, NULL, GL_STREAM_DRAW);
+	}
+
+	StreamingBuffer::~StreamingBuffer()
+	{
+		for (unsigned int i = 0; i < regionCount; i++)
+			if (fences[i])
+				glDeleteSync(fences[i]);
+		if (mapped)
+		{
+			GLState::bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+			glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		}
+		GLState::forgetBuffer(handle);
+		glDeleteBuffers(1, &handle);
+	}
+
+	void StreamingBuffer::waitFence(unsigned int region)
+	{
+		if (!fences[region])
+			return;
+		// flush on the first try only, the commands are on their way after that
+		GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		while (glClientWaitSync(fences[region], flags, 1000000) == GL_TIMEOUT_EXPIRED)
+			flags = 0;
+		glDeleteSync(fences[region]);
+		fences[region] = NULL;
+	}
+
+	StreamingBuffer::Allocation StreamingBuffer::allocate(size_t size, size_t alignment)
+	{
+		size_t begin = (head + alignment - 1) / alignment * alignment;
+		if (begin + size > regionSize)
+		{
+			std::cerr << "ERROR | XGL::StreamingBuffer::allocate(size_t, size_t) : Region full.\n";
+			throw REGION_FULL;
+		}
+
+		if (!persistent && !mapped)
+		{
+			GLState::bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+			// nothing past head in this storage has been handed out yet, so no synchronization is needed
+			mapped = (char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, region * regionSize + head, regionSize - head,
+				GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+			if (!mapped)
+			{
+				std::cerr << "ERROR | XGL::StreamingBuffer::allocate(size_t, size_t) : Failed to map buffer.\n";
+				throw MAP_FAIL;
+			}
+			mappedBegin = head;
+		}
+
+		Allocation res;
+		res.offset = region * regionSize + begin;
+		res.pointer = persistent ? mapped + res.offset : mapped + (begin - mappedBegin);
+		head = begin + size;
+		return res;
+	}
+
+	void StreamingBuffer::commit()
+	{
+		if (persistent || !mapped)
+			return;
+		GLState::bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		mapped = NULL;
+	}
+
+	void StreamingBuffer::endFrame()
+	{
+		commit();
+		if (persistent)
+			fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		region = (region + 1) % regionCount;
+		head = 0;
+		if (persistent)
+			waitFence(region);
+		else if (region == 0)
+		{
+			// a fresh storage on every wrap, even after frames without allocations; the driver keeps the old one
+			// alive for the frames still reading it, and there are no fences to wait on here
+			GLState::bindBuffer(GL_COPY_WRITE_BUFFER, handle);
+			glBufferData(GL_COPY_WRITE_BUFFER, regionCount * regionSize, NULL, GL_STREAM_DRAW);
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef XGL_STREAMINGBUFFER_H
+#define XGL_STREAMINGBUFFER_H
+
+#include "GLState/GLState.h"
+#include <glad/glad.h>
+
+#include <cstddef>
+
+namespace XGL
+{
+	// Per-frame vertex, index or uniform data written straight into driver memory.
+	// The buffer is split into regionCount regions used round robin, one per frame. Allocations are bumped
+	// from the current region and endFrame() moves on to the next.
+	// With GL 4.4 storage the whole buffer stays persistently and coherently mapped, and a fence per region keeps
+	// the CPU from overwriting data the GPU has not read yet.
+	// On older contexts the free part of the current region is mapped unsynchronized on demand, and the storage
+	// is orphaned each time the ring wraps; the mapping must then be released by commit() before drawing.
+	class StreamingBuffer
+	{
+		public:
+			enum ERROR { REGION_FULL, MAP_FAIL };
+
+			static const unsigned int regionCount = 3;
+
+			typedef struct
+			{
+				void* pointer;
+				size_t offset;	// from the start of the buffer, for attribute pointers, index offsets and glBindBufferRange
+			} Allocation;
+
+		private:
+			unsigned int handle;
+			size_t regionSize;
+			bool persistent;
+
+			unsigned int region;
+			size_t head;
+			GLsync fences[regionCount];
+
+			char* mapped;		// persistent: the whole buffer, otherwise the mapped tail of the region or NULL
+			size_t mappedBegin;	// offset within the region of mapped, fallback only
+
+			void waitFence(unsigned int region);
+
+		public:
+			StreamingBuffer(size_t regionSize);
+			StreamingBuffer(const StreamingBuffer&) = delete;
+			StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+			~StreamingBuffer();
+
+			// the pointer stays valid until commit() or endFrame()
+			Allocation allocate(size_t size, size_t alignment = 16);
+			// to be called before draws read this frame's allocations, a no-op with persistent mapping
+			void commit();
+			// to be called once the frame's draws are issued
+			void endFrame();
+
+			unsigned int getHandle() { return handle; }
+			size_t getRegionSize() { return regionSize; }
+			size_t getUsed() { return head; }
+			bool isPersistent() { return persistent; }
+	};
+}
+
+#endif // !XGL_STREAMINGBUFFER_H
@@ -4,17 +4,138 @@
 
 namespace XGL
 {
-	void Texture::load(const char* filename)
+	Texture::~Texture()
+	{
+		if (pending.valid())
+			stbi_image_free(pending.get().data);
+		stbi_image_free(data);
+		GLState::forgetTexture(handle);
+		glDeleteTextures(1, &handle);
+	}
+
+	Texture::Image Texture::decode(const std::string& filename)
 	{
+		Image res;
+		const char* file = filename.c_str();
+		// the flag is per thread, workers must set it themselves
+		stbi_set_flip_vertically_on_load_thread(true);
+		// the channels are kept as stored, wider sources keep their precision
+		if (stbi_is_hdr(file))
+		{
+			res.data = (unsigned char*)stbi_loadf(file, &res.width, &res.height, &res.channel, 0);
+			res.type = FLOAT;
+		}
+		else if (stbi_is_16_bit(file))
+		{
+			res.data = (unsigned char*)stbi_load_16(file, &res.width, &res.height, &res.channel, 0);
+			res.type = UNSIGNED_SHORT;
+		}
+		else
+		{
+			res.data = stbi_load(file, &res.width, &res.height, &res.channel, 0);
+			res.type = UNSIGNED_BYTE;
+		}
+		return res;
+	}
+
+	void Texture::finishLoad()
+	{
+		Image image = pending.get();
+		if (!image.data)
+		{
+			std::cerr << "ERROR | XGL::Texture::finishLoad() : Failed to open file \"" << pendingFile << "\".\n";
+			throw FILE_OPEN_FAIL;
+		}
 		if (data)
 			stbi_image_free(data);
-		stbi_set_flip_vertically_on_load(true);
-		data = stbi_load(filename, &width, &height, &channel, 3);
-		if (!data)
+		data = image.data;
+		width = image.width;
+		height = image.height;
+		channel = image.channel;
+		type = image.type;
+		// a chain built with other settings is dropped, generate() builds the right one
+		if (image.mipmapFilter == mipmapFilter && image.sRGB == sRGBEnabled)
+			mipmaps.swap(image.mipmaps);
+		else
+			mipmaps.clear();
+	}
+
+	void Texture::load(const char* filename)
+	{
+		// a newer load replaces one still decoding
+		if (pending.valid())
+			stbi_image_free(pending.get().data);
+		Image image = decode(filename);
+		if (!image.data)
 		{
 			std::cerr << "ERROR | XGL::Texture::load(const char*) : Failed to open file \"" << filename << "\".\n";
 			throw FILE_OPEN_FAIL;
 		}
+		if (data)
+			stbi_image_free(data);
+		data = image.data;
+		width = image.width;
+		height = image.height;
+		channel = image.channel;
+		type = image.type;
+		mipmaps.clear();
+	}
+
+	void Texture::loadAsync(const char* filename)
+	{
+		if (pending.valid())
+			stbi_image_free(pending.get().data);
+		pendingFile = filename;
+		std::string file = filename;
+		bool chain = mipmapEnabled;
+		MipmapFilter filter = mipmapFilter;
+		Compression compression = this->compression;
+		bool sRGB = sRGBEnabled;
+		pending = ThreadPool::global().submit([=]()
+		{
+			Image image = decode(file);
+			image.mipmapFilter = filter;
+			image.sRGB = sRGB;
+			// already on a worker, the levels are not split any further
+			if (image.data && chain && (filter != DRIVER || (compression != RAW && image.type == UNSIGNED_BYTE)))
+				image.mipmaps = buildChain(image.data, image.width, image.height, image.channel, image.type, filter, sRGB, false);
+			return image;
+		});
+	}
+
+	bool Texture::isReady()
+	{
+		return !pending.valid() || pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+
+	void Texture::releaseData()
+	{
+		stbi_image_free(data);
+		data = NULL;
+		mipmaps.clear();
+	}
+
+	void Texture::loadBatch(const std::vector<Texture*>& textures, const std::vector<const char*>& filenames,
+		unsigned int maxInFlight, bool keepData)
+	{
+		if (textures.size() != filenames.size())
+		{
+			std::cerr << "ERROR | XGL::Texture::loadBatch(const std::vector<Texture*>&, const std::vector<const char*>&, unsigned int, bool) : Size mismatch.\n";
+			throw SIZE_MISMATCH;
+		}
+		if (!maxInFlight)
+			maxInFlight = 1;
+
+		// a window of maxInFlight decodes, the oldest is uploaded before the next one is started
+		size_t started = 0;
+		for (size_t i = 0; i < textures.size(); i++)
+		{
+			for (; started < textures.size() && started < i + maxInFlight; started++)
+				textures[started]->loadAsync(filenames[started]);
+			textures[i]->generate();
+			if (!keepData)
+				textures[i]->releaseData();
+		}
 	}
 
 	void Texture::setWrappingPolicy(WrappingPolicy x, WrappingPolicy y)
@@ -31,6 +152,19 @@ namespace XGL
 	void Texture::setMipmapEnabled(bool isEnabled)
 	{
 		mipmapEnabled = isEnabled;
+		mipmaps.clear();
+	}
+
+	void Texture::setMipmapFilter(MipmapFilter filter)
+	{
+		mipmapFilter = filter;
+		mipmaps.clear();
+	}
+
+	void Texture::setSRGBEnabled(bool isEnabled)
+	{
+		sRGBEnabled = isEnabled;
+		mipmaps.clear();
 	}
 
 	void Texture::setSamplingPolicy(SamplingPolicy min, SamplingPolicy mag)
@@ -54,19 +188,107 @@ namespace XGL
 		borderColor = color;
 	}
 
-	void Texture::generate()
+	void Texture::setCompression(Compression compression)
+	{
+		this->compression = compression;
+	}
+
+	size_t Texture::getLevelSize(int width, int height, int channel, PixelType type, Compression compression)
+	{
+		switch (compression)
+		{
+			case BC1:
+				return BlockCompression::getSize(BlockCompression::BC1, width, height);
+			case BC3:
+				return BlockCompression::getSize(BlockCompression::BC3, width, height);
+			default:
+				return (size_t)width * height * channel * (type == UNSIGNED_BYTE ? 1 : type == UNSIGNED_SHORT ? 2 : 4);
+		}
+	}
+
+	unsigned int Texture::getFormatGL(int channel)
 	{
+		static const unsigned int formats[4] = { GL_RED, GL_RG, GL_RGB, GL_RGBA };
+		return formats[channel - 1];
+	}
+
+	unsigned int Texture::getInternalFormatGL(int channel, PixelType type, bool sRGB)
+	{
+		if (sRGB && type == UNSIGNED_BYTE && channel >= 3)
+			return channel == 3 ? GL_SRGB8 : GL_SRGB8_ALPHA8;
+		static const unsigned int formats[3][4] = {
+			{ GL_R8, GL_RG8, GL_RGB8, GL_RGBA8 },
+			{ GL_R16, GL_RG16, GL_RGB16, GL_RGBA16 },
+			// HDR sources are never negative, packed RGB floats take 4 bytes against 6 for GL_RGB16F
+			{ GL_R16F, GL_RG16F, GL_R11F_G11F_B10F, GL_RGBA16F }
+		};
+		return formats[type][channel - 1];
+	}
+
+	unsigned int Texture::getTypeGL(PixelType type)
+	{
+		static const unsigned int types[3] = { GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_FLOAT };
+		return types[type];
+	}
+
+	void Texture::uploadLevel(int level, int width, int height, int channel, PixelType type, bool sRGB, const void* texels)
+	{
+		// the widest alignment the rows allow, only odd row sizes need byte alignment
+		size_t row = getLevelSize(width, 1, channel, type);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, row % 8 == 0 ? 8 : row % 4 == 0 ? 4 : row % 2 == 0 ? 2 : 1);
+		glTexImage2D(GL_TEXTURE_2D, level, getInternalFormatGL(channel, type, sRGB), width, height, 0,
+			getFormatGL(channel), getTypeGL(type), texels);
+	}
+
+	std::vector<std::vector<unsigned char>> Texture::buildChain(const unsigned char* data, int width, int height, int channel,
+		PixelType type, MipmapFilter filter, bool sRGB, bool parallel)
+	{
+		Mipmap::Filter kernel = filter == LANCZOS ? Mipmap::LANCZOS : filter == KAISER ? Mipmap::KAISER : Mipmap::BOX;
+		std::vector<std::vector<unsigned char>> chain;
+		const unsigned char* src = data;
+		while (width > 1 || height > 1)
+		{
+			int levelWidth = Mipmap::getLevelSize(width), levelHeight = Mipmap::getLevelSize(height);
+			chain.emplace_back(getLevelSize(levelWidth, levelHeight, channel, type));
+			unsigned char* dst = chain.back().data();
+			switch (type)
+			{
+				case UNSIGNED_BYTE:
+					Mipmap::downsample(src, width, height, channel, dst, kernel, sRGB, parallel); break;
+				case UNSIGNED_SHORT:
+					Mipmap::downsample((const unsigned short*)src, width, height, channel, (unsigned short*)dst, kernel, sRGB, parallel); break;
+				case FLOAT:
+					Mipmap::downsample((const float*)src, width, height, channel, (float*)dst, kernel, parallel); break;
+			}
+			src = dst;
+			width = levelWidth;
+			height = levelHeight;
+		}
+		return chain;
+	}
+
+	void Texture::buildMipmaps()
+	{
+		if (pending.valid())
+			finishLoad();
 		if (!data)
 		{
-			std::cerr << "ERROR | XGL::Texture::generate() : No image data.\n";
+			std::cerr << "ERROR | XGL::Texture::buildMipmaps() : No image data.\n";
 			throw NO_IMAGE_DATA;
 		}
+		mipmaps = buildChain(data, width, height, channel, type, mipmapFilter, sRGBEnabled, true);
+	}
 
+	void Texture::createHandle()
+	{
 		if (handle)
+		{
+			GLState::forgetTexture(handle);
 			glDeleteTextures(1, &handle);
+		}
 
 		glGenTextures(1, &handle);
-		glBindTexture(GL_TEXTURE_2D, handle);
+		GLState::bindTexture(0, handle);
 
 		switch (wrappingX)
 		{
@@ -152,12 +374,101 @@ namespace XGL
 		}
 
 		glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor.getData());
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-		if (mipmapEnabled)
-			glGenerateMipmap(GL_TEXTURE_2D);
+		// gray images sample as gray rather than red, the block encoder expands them itself
+		if (getCompression() == RAW && channel <= 2)
+		{
+			int swizzle[4] = { GL_RED, GL_RED, GL_RED, channel == 1 ? GL_ONE : GL_GREEN };
+			glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+		}
+	}
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+	std::vector<const unsigned char*> Texture::buildLevels(std::vector<std::vector<unsigned char>>& blocks)
+	{
+		if (pending.valid())
+			finishLoad();
+		if (!data)
+		{
+			std::cerr << "ERROR | XGL::Texture::buildLevels(std::vector<std::vector<unsigned char>>&) : No image data.\n";
+			throw NO_IMAGE_DATA;
+		}
+
+		// glGenerateMipmap cannot run on compressed formats, their chain is always built here
+		bool compressed = getCompression() != RAW;
+		if (mipmapEnabled && (mipmapFilter != DRIVER || compressed) && mipmaps.empty())
+			buildMipmaps();
+		std::vector<const unsigned char*> levels(1, data);
+		for (size_t i = 0; i < mipmaps.size(); i++)
+			levels.push_back(mipmaps[i].data());
+
+		if (!compressed)
+			return levels;
+
+		BlockCompression::Format format = compression == BC1 ? BlockCompression::BC1 : BlockCompression::BC3;
+		blocks.assign(levels.size(), std::vector<unsigned char>());
+		std::vector<const unsigned char*> encoded;
+		for (size_t i = 0; i < levels.size(); i++)
+		{
+			int levelWidth = width >> i > 0 ? width >> i : 1;
+			int levelHeight = height >> i > 0 ? height >> i : 1;
+			blocks[i].resize(BlockCompression::getSize(format, levelWidth, levelHeight));
+			BlockCompression::encodeParallel(format, levels[i], levelWidth, levelHeight, channel, blocks[i].data());
+			encoded.push_back(blocks[i].data());
+		}
+		return encoded;
+	}
+
+	void Texture::generate()
+	{
+		std::vector<std::vector<unsigned char>> blocks;
+		std::vector<const unsigned char*> levels = buildLevels(blocks);
+		upload(levels, getCompression());
+	}
+
+	void Texture::generateLevels(int width, int height, int channel, PixelType type,
+		const std::vector<const unsigned char*>& levels, Compression compression)
+	{
+		if (levels.empty())
+		{
+			std::cerr << "ERROR | XGL::Texture::generateLevels(int, int, int, PixelType, const std::vector<const unsigned char*>&, Compression) : No image data.\n";
+			throw NO_IMAGE_DATA;
+		}
+		if (channel < 1 || channel > 4 || (compression != RAW && type != UNSIGNED_BYTE))
+		{
+			std::cerr << "ERROR | XGL::Texture::generateLevels(int, int, int, PixelType, const std::vector<const unsigned char*>&, Compression) : Invalid format.\n";
+			throw INVALID_FORMAT;
+		}
+		this->width = width;
+		this->height = height;
+		this->channel = channel;
+		this->type = type;
+		// only 8 bit images can carry a compression, the setting of the others is kept for later loads
+		if (type == UNSIGNED_BYTE)
+			this->compression = compression;
+		mipmaps.clear();
+		upload(levels, compression);
+	}
+
+	void Texture::upload(const std::vector<const unsigned char*>& levels, Compression storage)
+	{
+		createHandle();
+		for (size_t i = 0; i < levels.size(); i++)
+		{
+			int levelWidth = width >> i > 0 ? width >> i : 1;
+			int levelHeight = height >> i > 0 ? height >> i : 1;
+			if (storage == RAW)
+				uploadLevel((int)i, levelWidth, levelHeight, channel, type, sRGBEnabled, levels[i]);
+			else
+				glCompressedTexImage2D(GL_TEXTURE_2D, (int)i,
+					BlockCompression::getFormatGL(storage == BC1 ? BlockCompression::BC1 : BlockCompression::BC3, sRGBEnabled),
+					levelWidth, levelHeight, 0, (int)getLevelSize(levelWidth, levelHeight, channel, type, storage), levels[i]);
+		}
+
+		// only the base level was given, the driver builds the rest
+		if (mipmapEnabled && levels.size() == 1 && storage == RAW)
+			glGenerateMipmap(GL_TEXTURE_2D);
+		else
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (int)levels.size() - 1);
 	}
 
 	void Texture::bind(unsigned int texUnit)
@@ -167,7 +478,6 @@ namespace XGL
 			std::cerr << "ERROR | XGL::Texture::bind(unsigned int) : Not generated.\n";
 			throw NOT_GENERATED;
 		}
-		glActiveTexture(GL_TEXTURE0 + texUnit);
-		glBindTexture(GL_TEXTURE_2D, handle);
+		GLState::bindTexture(texUnit, handle);
 	}
 }
\ No newline at end of file
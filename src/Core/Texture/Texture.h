@@ -3,62 +3,159 @@
 
 #include <stb_image.h>
 #include <glad/glad.h>
+#include "GLState/GLState.h"
+#include "ThreadPool/ThreadPool.h"
+#include "BlockCompression/BlockCompression.h"
+#include "Mipmap/Mipmap.h"
+#include <future>
+#include <string>
+#include <vector>
 #include <Math/Vector.h>
 
 namespace XGL
 {
 	class Texture
 	{
+		friend class TextureCache;
+
 		public:
-			enum ERROR { FILE_OPEN_FAIL, NO_IMAGE_DATA, NOT_GENERATED };
+			enum ERROR { FILE_OPEN_FAIL, NO_IMAGE_DATA, NOT_GENERATED, SIZE_MISMATCH, INVALID_FORMAT };
 			enum WrappingPolicy { REPEAT, MIRRORED_REPEAT, CLAMP_TO_EDGE, CLAMP_TO_BORDER };
 			enum SamplingPolicy { NEAREST, LINEAR };
+			// RAW keeps the texels as loaded, BC1 and BC3 are encoded on the CPU before upload
+			enum Compression { RAW, BC1, BC3 };
+			// per channel storage: 8 bit, 16 bit ( 16 bit PNG ), float ( Radiance HDR )
+			enum PixelType { UNSIGNED_BYTE, UNSIGNED_SHORT, FLOAT };
+			// DRIVER leaves the chain to glGenerateMipmap, the others build it on the CPU with Mipmap;
+			// compressed textures always take the CPU path, DRIVER then meaning BOX
+			enum MipmapFilter { DRIVER, BOX, LANCZOS, KAISER };
 
 		private:
+			typedef struct
+			{
+				unsigned char* data;	// NULL if decoding failed
+				int width;
+				int height;
+				int channel;
+				PixelType type;
+				std::vector<std::vector<unsigned char>> mipmaps;
+				// the settings mipmaps was built with, the texture's may have changed since
+				MipmapFilter mipmapFilter;
+				bool sRGB;
+			} Image;
+
 			// --- image info ---
-			unsigned char* data;
+			unsigned char* data;	// width * height * channel values of type, rows bottom up
 			int width;
 			int height;
-			int channel;
+			int channel;			// as stored in the file, 1 gray, 2 gray and alpha, 3 RGB, 4 RGBA
+			PixelType type;
+			std::vector<std::vector<unsigned char>> mipmaps;	// levels 1 and up when built on the CPU
+
+			// --- decoding on the thread pool ---
+			std::future<Image> pending;
+			std::string pendingFile;
+
+			static Image decode(const std::string& filename);
+			// takes over the image of loadAsync(), waiting for it if needed
+			void finishLoad();
+			// a new GL texture bound to unit 0, with the wrapping and sampling policies applied
+			void createHandle();
+			// levels 1 down to 1x1 of the image, parallel as for Mipmap::downsample
+			static std::vector<std::vector<unsigned char>> buildChain(const unsigned char* data, int width, int height, int channel,
+				PixelType type, MipmapFilter filter, bool sRGB, bool parallel);
+			// a new handle holding levels, in the given storage
+			void upload(const std::vector<const unsigned char*>& levels, Compression storage);
+			// glTexImage2D of one raw level with the formats matching channel and type
+			static void uploadLevel(int level, int width, int height, int channel, PixelType type, bool sRGB, const void* texels);
 
 			// --- GL info ---
 			unsigned int handle;
 
 			// --- property ---
 			bool mipmapEnabled;
+			MipmapFilter mipmapFilter;
+			bool sRGBEnabled;
 			WrappingPolicy wrappingX;
 			WrappingPolicy wrappingY;
 			SamplingPolicy sampingMin;
 			SamplingPolicy sampingMag;
 			SamplingPolicy sampingMipmap;
 			Vec4 borderColor;
+			Compression compression;
 
 
 		public:
-			Texture() : data(NULL), handle(0), mipmapEnabled(true),
+			Texture() : data(NULL), width(0), height(0), channel(0), type(UNSIGNED_BYTE), handle(0),
+				mipmapEnabled(true), mipmapFilter(DRIVER), sRGBEnabled(false),
 				wrappingX(REPEAT), wrappingY(REPEAT),
 				sampingMin(LINEAR), sampingMag(LINEAR), sampingMipmap(LINEAR),
-				borderColor(0, 0, 0, 1) {}
+				borderColor(0, 0, 0, 1), compression(RAW) {}
 			Texture(const char* filename) : Texture() { load(filename); }
-			~Texture() { stbi_image_free(data); glDeleteTextures(1, &handle); }
+			~Texture();
 
 			unsigned char* getData() { return data; }
 			int getWidth() { return width; }
 			int getHeight() { return height; }
+			int getChannel() { return channel; }
+			PixelType getPixelType() { return type; }
+			bool isMipmapEnabled() { return mipmapEnabled; }
+			// the storage actually used, RAW for images that are not 8 bit
+			Compression getCompression() { return type == UNSIGNED_BYTE ? compression : RAW; }
+			// as set, whatever the image turns out to be
+			Compression getCompressionSetting() { return compression; }
+			MipmapFilter getMipmapFilter() { return mipmapFilter; }
+			bool isSRGBEnabled() { return sRGBEnabled; }
 			unsigned int getHandle() { return handle; }
 
 			void load(const char* filename);
+			// decodes on ThreadPool::global(), generate() waits for it if it is still running;
+			// a CPU mip chain is built there as well, with the mipmap settings of the time of the call
+			void loadAsync(const char* filename);
+			// false while an asynchronous load is still decoding
+			bool isReady();
+			// drops the CPU copy of the pixels, generate() is then no longer possible
+			void releaseData();
 			void setMipmapEnabled(bool isEnabled);
+			void setMipmapFilter(MipmapFilter filter);
+			// color channels hold sRGB encoded values: 8 bit RGB and RGBA images, compressed or not, are stored in
+			// sRGB formats, so sampling and glGenerateMipmap work in linear light, and so do CPU mipmaps for every image
+			void setSRGBEnabled(bool isEnabled);
 			void setWrappingPolicy(WrappingPolicy x, WrappingPolicy y);
 			void setWrappingPolicy(WrappingPolicy policy);
 			void setSamplingPolicy(SamplingPolicy min, SamplingPolicy mag);
 			void setSamplingPolicy(SamplingPolicy policy);
 			void setMipmapSamplingPolicy(SamplingPolicy policy);
 			void setBorderColor(Vec4 color);
+			// only 8 bit images are compressed, the others are uploaded raw
+			void setCompression(Compression compression);
 
+			// the CPU mip chain of the loaded image, generate() builds it itself when needed; no GL is involved
+			void buildMipmaps();
+			// the levels generate() uploads, in the storage of getCompression(): the image, its CPU mip chain
+			// and, when compressed, their blocks kept in blocks; with DRIVER mipmaps of a raw image only the base level.
+			// No GL is involved, the pointers stay valid until the texture or blocks change
+			std::vector<const unsigned char*> buildLevels(std::vector<std::vector<unsigned char>>& blocks);
 			bool isGenerated() { return handle; }
 			void generate();
+			// uploads a ready mip chain of texels, or of blocks when compressed, instead of the loaded image,
+			// level i being max(1, width >> i) by max(1, height >> i); a single raw level is completed by glGenerateMipmap
+			void generateLevels(int width, int height, int channel, PixelType type,
+				const std::vector<const unsigned char*>& levels, Compression compression = RAW);
 			void bind(unsigned int texUnit);
+
+			// bytes of one level in the given storage
+			static size_t getLevelSize(int width, int height, int channel, PixelType type, Compression compression = RAW);
+			// GL_RED to GL_RGBA, and the matching sized internal format, e.g. GL_RG8 or GL_RGBA16F
+			static unsigned int getFormatGL(int channel);
+			// sRGB only applies to 8 bit RGB and RGBA, GL has no sRGB format for the others
+			static unsigned int getInternalFormatGL(int channel, PixelType type, bool sRGB = false);
+			static unsigned int getTypeGL(PixelType type);
+
+			// loads and generates every texture with at most maxInFlight images decoding or decoded but not yet uploaded,
+			// the pixels are released once uploaded unless keepData is set
+			static void loadBatch(const std::vector<Texture*>& textures, const std::vector<const char*>& filenames,
+				unsigned int maxInFlight = 8, bool keepData = false);
 	};
 }
 
@@ -0,0 +1,227 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+namespace XGL
+{
+	TextureAtlas::TextureAtlas(int pageSize, int padding) : pageSize(pageSize), padding(padding > 0 ? padding : 0), levelCount(1)
+	{
+		// level k keeps its images apart while the padding is at least 2^k texels
+		while (2 << (levelCount - 1) <= this->padding)
+			levelCount++;
+	}
+
+	void TextureAtlas::clearPages()
+	{
+		for (size_t i = 0; i < pages.size(); i++)
+			delete pages[i];
+		pages.clear();
+	}
+
+	size_t TextureAtlas::add(Texture& texture)
+	{
+		if (!texture.getData())
+		{
+			std::cerr << "ERROR | XGL::TextureAtlas::add(Texture&) : No image data.\n";
+			throw NO_IMAGE_DATA;
+		}
+		if (entries.size() && (texture.getChannel() != entries[0].texture->getChannel() ||
+			texture.getPixelType() != entries[0].texture->getPixelType()))
+		{
+			std::cerr << "ERROR | XGL::TextureAtlas::add(Texture&) : Format mismatch.\n";
+			throw FORMAT_MISMATCH;
+		}
+		int align = 1 << (levelCount - 1);
+		if ((texture.getWidth() + 2 * padding + align - 1) / align * align > pageSize ||
+			(texture.getHeight() + 2 * padding + align - 1) / align * align > pageSize)
+		{
+			std::cerr << "ERROR | XGL::TextureAtlas::add(Texture&) : Image too large.\n";
+			throw IMAGE_TOO_LARGE;
+		}
+		entries.push_back({ &texture, 0, 0, texture.getWidth(), texture.getHeight(), 0 });
+		return entries.size() - 1;
+	}
+
+	bool TextureAtlas::place(std::vector<Segment>& skyline, int pageSize, int width, int height, int& x, int& y)
+	{
+		// the lowest top edge wins, then the leftmost
+		int bestTop = INT_MAX;
+		for (size_t i = 0; i < skyline.size() && skyline[i].x + width <= pageSize; i++)
+		{
+			int base = 0;
+			for (size_t j = i; j < skyline.size() && skyline[j].x < skyline[i].x + width; j++)
+				base = skyline[j].y > base ? skyline[j].y : base;
+			if (base + height <= pageSize && base + height < bestTop)
+			{
+				bestTop = base + height;
+				x = skyline[i].x;
+				y = base;
+			}
+		}
+		if (bestTop == INT_MAX)
+			return false;
+
+		// the cell replaces the segments below it, a partly covered last one keeps its uncovered end
+		std::vector<Segment> res;
+		for (size_t i = 0; i < skyline.size(); i++)
+		{
+			const Segment& s = skyline[i];
+			int end = s.x + s.width;
+			if (s.x == x)
+				res.push_back({ x, bestTop, width });
+			if (end <= x || s.x >= x + width)
+				res.push_back(s);
+			else if (end > x + width)
+				res.push_back({ x + width, s.y, end - x - width });
+		}
+		skyline.clear();
+		for (size_t i = 0; i < res.size(); i++)
+			if (skyline.size() && skyline.back().y == res[i].y)
+				skyline.back().width += res[i].width;
+			else
+				skyline.push_back(res[i]);
+		return true;
+	}
+
+	void TextureAtlas::build()
+	{
+		clearPages();
+		regions.assign(entries.size(), Region());
+		if (entries.empty())
+			return;
+
+		// cells start on multiples of the last level's footprint so that every level halves them exactly
+		int align = 1 << (levelCount - 1);
+		std::vector<size_t> order(entries.size());
+		for (size_t i = 0; i < order.size(); i++)
+			order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [this](size_t l, size_t r)
+		{
+			return entries[l].height != entries[r].height ? entries[l].height > entries[r].height : entries[l].width > entries[r].width;
+		});
+
+		std::vector<std::vector<Segment>> skylines;
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			Entry& entry = entries[order[i]];
+			int cellWidth = (entry.width + 2 * padding + align - 1) / align * align;
+			int cellHeight = (entry.height + 2 * padding + align - 1) / align * align;
+			size_t page = 0;
+			while (page < skylines.size() && !place(skylines[page], pageSize, cellWidth, cellHeight, entry.x, entry.y))
+				page++;
+			if (page == skylines.size())
+			{
+				skylines.push_back(std::vector<Segment>(1, { 0, 0, pageSize }));
+				place(skylines[page], pageSize, cellWidth, cellHeight, entry.x, entry.y);
+			}
+			entry.page = (unsigned int)page;
+		}
+
+		int channel = entries[0].texture->getChannel();
+		Texture::PixelType type = entries[0].texture->getPixelType();
+		size_t texel = Texture::getLevelSize(1, 1, channel, type);
+		for (size_t page = 0; page < skylines.size(); page++)
+		{
+			// pages shrink to the cells they hold
+			int width = 0, height = 0;
+			for (size_t i = 0; i < entries.size(); i++)
+				if (entries[i].page == page)
+				{
+					width = std::max(width, (entries[i].x + entries[i].width + 2 * padding + align - 1) / align * align);
+					height = std::max(height, (entries[i].y + entries[i].height + 2 * padding + align - 1) / align * align);
+				}
+
+			std::vector<std::vector<unsigned char>> levels(1, std::vector<unsigned char>(Texture::getLevelSize(width, height, channel, type)));
+			for (size_t i = 0; i < entries.size(); i++)
+			{
+				const Entry& entry = entries[i];
+				if (entry.page != page)
+					continue;
+				const unsigned char* src = entry.texture->getData();
+				for (int y = -padding; y < entry.height + padding; y++)
+				{
+					// the padding repeats the edge texels
+					int row = y < 0 ? 0 : y >= entry.height ? entry.height - 1 : y;
+					const unsigned char* in = src + (size_t)row * entry.width * texel;
+					unsigned char* out = levels[0].data() + ((size_t)(entry.y + padding + y) * width + entry.x) * texel;
+					for (int x = 0; x < padding; x++)
+						memcpy(out + x * texel, in, texel);
+					memcpy(out + padding * texel, in, entry.width * texel);
+					for (int x = 0; x < padding; x++)
+						memcpy(out + (padding + entry.width + x) * texel, in + (entry.width - 1) * texel, texel);
+				}
+
+				Region& region = regions[i];
+				region.page = entry.page;
+				region.offset = Vec2((float)(entry.x + padding) / width, (float)(entry.y + padding) / height);
+				region.scale = Vec2((float)entry.width / width, (float)entry.height / height);
+			}
+
+			int levelWidth = width, levelHeight = height;
+			for (int level = 1; level < levelCount && (levelWidth > 1 || levelHeight > 1); level++)
+			{
+				levels.emplace_back(Texture::getLevelSize(Mipmap::getLevelSize(levelWidth), Mipmap::getLevelSize(levelHeight), channel, type));
+				const unsigned char* src = levels[level - 1].data();
+				unsigned char* dst = levels[level].data();
+				switch (type)
+				{
+					case Texture::UNSIGNED_BYTE:
+						Mipmap::downsample(src, levelWidth, levelHeight, channel, dst); break;
+					case Texture::UNSIGNED_SHORT:
+						Mipmap::downsample((const unsigned short*)src, levelWidth, levelHeight, channel, (unsigned short*)dst); break;
+					case Texture::FLOAT:
+						Mipmap::downsample((const float*)src, levelWidth, levelHeight, channel, (float*)dst); break;
+				}
+				levelWidth = Mipmap::getLevelSize(levelWidth);
+				levelHeight = Mipmap::getLevelSize(levelHeight);
+			}
+
+			std::vector<const unsigned char*> data;
+			for (size_t i = 0; i < levels.size(); i++)
+				data.push_back(levels[i].data());
+			Texture* texture = new Texture();
+			texture->setWrappingPolicy(Texture::CLAMP_TO_EDGE);
+			texture->setMipmapEnabled(levelCount > 1);
+			texture->generateLevels(width, height, channel, type, data);
+			pages.push_back(texture);
+		}
+	}
+
+	Texture& TextureAtlas::getPage(size_t idx)
+	{
+		if (idx >= pages.size())
+		{
+			std::cerr << "ERROR | XGL::TextureAtlas::getPage(size_t) : Index out of range.\n";
+			throw OUT_OF_RANGE;
+		}
+		return *pages[idx];
+	}
+
+	const TextureAtlas::Region& TextureAtlas::getRegion(size_t idx)
+	{
+		if (idx >= regions.size())
+		{
+			std::cerr << "ERROR | XGL::TextureAtlas::getRegion(size_t) : Index out of range.\n";
+			throw OUT_OF_RANGE;
+		}
+		return regions[idx];
+	}
+
+	Vec2 TextureAtlas::transform(size_t idx, Vec2 texcoord)
+	{
+		const Region& region = getRegion(idx);
+		return Vec2(region.offset.x() + texcoord.x() * region.scale.x(), region.offset.y() + texcoord.y() * region.scale.y());
+	}
+
+	void TextureAtlas::apply(Object& object, size_t idx, const char* name)
+	{
+		std::vector<Vec2> texcoords = object.getModelTexcoords();
+		for (size_t i = 0; i < texcoords.size(); i++)
+			texcoords[i] = transform(idx, texcoords[i]);
+		object.setModelTexcoords(texcoords);
+		object.addTexture(*pages[getRegion(idx).page], name);
+	}
+}
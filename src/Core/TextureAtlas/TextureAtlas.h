@@ -0,0 +1,84 @@
+#ifndef XGL_TEXTUREATLAS_H
+#define XGL_TEXTUREATLAS_H
+
+#include <Math/Vector.h>
+#include "Object/Object.h"
+#include "Texture/Texture.h"
+#include "Mipmap/Mipmap.h"
+
+#include <vector>
+
+namespace XGL
+{
+	// Many small loaded images packed into a few large page Textures with a skyline packer, tallest image first.
+	// Objects whose images landed on the same page get the same texture list from apply(), so RenderQueue sorts
+	// them next to each other and their draws share one bind; a MeshPool can texture all of its meshes from one page.
+	// Each image is surrounded by padding texels repeating its edge, and pages keep the mip levels that padding
+	// covers, 1 + log2(padding) of them, so filtering never reaches a neighbour. Texcoords are expected within
+	// [0, 1], REPEAT wrapping does not survive packing.
+	class TextureAtlas
+	{
+		public:
+			enum ERROR { NO_IMAGE_DATA, FORMAT_MISMATCH, IMAGE_TOO_LARGE, OUT_OF_RANGE };
+
+			// where an image ended up, uv on the page = offset + uv in the image * scale
+			typedef struct
+			{
+				unsigned int page;
+				Vec2 offset;
+				Vec2 scale;
+			} Region;
+
+		private:
+			typedef struct
+			{
+				Texture* texture;
+				int x;				// of the padded cell on its page
+				int y;
+				int width;			// of the image itself
+				int height;
+				unsigned int page;
+			} Entry;
+
+			// the top edge of the placed cells over [x, x + width)
+			typedef struct
+			{
+				int x;
+				int y;
+				int width;
+			} Segment;
+
+			int pageSize;
+			int padding;
+			int levelCount;
+			std::vector<Entry> entries;
+			std::vector<Region> regions;
+			std::vector<Texture*> pages;
+
+			// bottom-left placement of a width by height cell, false if the page has no room for it
+			static bool place(std::vector<Segment>& skyline, int pageSize, int width, int height, int& x, int& y);
+			void clearPages();
+
+		public:
+			TextureAtlas(int pageSize = 2048, int padding = 4);
+			TextureAtlas(const TextureAtlas&) = delete;
+			TextureAtlas& operator=(const TextureAtlas&) = delete;
+			~TextureAtlas() { clearPages(); }
+
+			// texture must hold its pixels until build(), every image sharing the channel count and pixel type
+			// of the first one; returns the index of its region
+			size_t add(Texture& texture);
+			// packs everything added so far and generates the pages, replacing those of a previous build
+			void build();
+
+			size_t getPageCount() { return pages.size(); }
+			Texture& getPage(size_t idx);
+			const Region& getRegion(size_t idx);
+			Vec2 transform(size_t idx, Vec2 texcoord);
+
+			// moves the object's texcoords into the region and adds its page as the texture name
+			void apply(Object& object, size_t idx, const char* name);
+	};
+}
+
+#endif // !XGL_TEXTUREATLAS_H
@@ -0,0 +1,324 @@
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+	#undef near
+	#undef far
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#include "TextureCache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+
+namespace XGL
+{
+	namespace
+	{
+		// read-only mapping of a whole file
+		class MappedFile
+		{
+			private:
+				const unsigned char* data;
+				size_t size;
+#ifdef _WIN32
+				HANDLE file;
+				HANDLE mapping;
+#endif
+
+			public:
+				MappedFile(const std::string& path) : data(NULL), size(0)
+				{
+#ifdef _WIN32
+					mapping = NULL;
+					file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+					if (file == INVALID_HANDLE_VALUE)
+						return;
+					LARGE_INTEGER length;
+					if (!GetFileSizeEx(file, &length) || !length.QuadPart)
+						return;
+					mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+					if (!mapping)
+						return;
+					data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+					if (data)
+						size = (size_t)length.QuadPart;
+#else
+					int fd = open(path.c_str(), O_RDONLY);
+					if (fd == -1)
+						return;
+					struct stat info;
+					if (!fstat(fd, &info) && info.st_size > 0)
+					{
+						void* ptr = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+						if (ptr != MAP_FAILED)
+						{
+							data = (const unsigned char*)ptr;
+							size = info.st_size;
+						}
+					}
+					close(fd);
+#endif
+				}
+
+				~MappedFile()
+				{
+#ifdef _WIN32
+					if (data)
+						UnmapViewOfFile(data);
+					if (mapping)
+						CloseHandle(mapping);
+					if (file != INVALID_HANDLE_VALUE)
+						CloseHandle(file);
+#else
+					if (data)
+						munmap((void*)data, size);
+#endif
+				}
+
+				const unsigned char* getData() { return data; }
+				size_t getSize() { return size; }
+		};
+
+		// FNV-1a, 64 bit
+		uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+		{
+			const unsigned char* bytes = (const unsigned char*)data;
+			for (size_t i = 0; i < size; i++)
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+			return hash;
+		}
+	}
+
+	TextureCache::TextureCache(const char* directory) : directory(directory)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(this->directory, error);
+	}
+
+	TextureCache::Settings TextureCache::settingsOf(Texture& texture)
+	{
+		Settings res;
+		res.compression = texture.getCompressionSetting();
+		res.mipmapEnabled = texture.isMipmapEnabled();
+		res.mipmapFilter = texture.getMipmapFilter();
+		res.sRGB = texture.isSRGBEnabled();
+		return res;
+	}
+
+	std::string TextureCache::entryPath(const char* filename, const Settings& settings)
+	{
+		char name[32];
+		uint64_t key = hashBytes(&settings, sizeof(Settings), hashBytes(filename, strlen(filename)));
+		snprintf(name, sizeof(name), "%016llx.xtc", (unsigned long long)key);
+		return (std::filesystem::path(directory) / name).string();
+	}
+
+	bool TextureCache::sourceInfo(const char* filename, int64_t& time, uint64_t& size)
+	{
+		std::error_code error;
+		size = std::filesystem::file_size(filename, error);
+		if (error)
+			return false;
+		time = std::filesystem::last_write_time(filename, error).time_since_epoch().count();
+		return !error;
+	}
+
+	uint64_t TextureCache::hashFile(const char* filename)
+	{
+		std::ifstream f(filename, std::ios::binary);
+		std::vector<char> chunk(1 << 16);
+		uint64_t hash = hashBytes(NULL, 0);
+		while (f)
+		{
+			f.read(chunk.data(), chunk.size());
+			hash = hashBytes(chunk.data(), (size_t)f.gcount(), hash);
+		}
+		return hash;
+	}
+
+	bool TextureCache::load(Texture& texture, const char* filename)
+	{
+		int64_t time;
+		uint64_t size;
+		if (!sourceInfo(filename, time, size))
+			return false;
+
+		Settings settings = settingsOf(texture);
+		std::string path = entryPath(filename, settings);
+		bool touched = false;
+		{
+			MappedFile entry(path);
+			const unsigned char* data = entry.getData();
+			if (!data || entry.getSize() < sizeof(Header))
+				return false;
+			Header header;
+			memcpy(&header, data, sizeof(Header));
+			if (memcmp(header.magic, "XGLT", 4) || header.version != version ||
+				header.channel < 1 || header.channel > 4 || header.type < Texture::UNSIGNED_BYTE || header.type > Texture::FLOAT ||
+				header.compression < Texture::RAW || header.compression > Texture::BC3 ||
+				(header.compression != Texture::RAW && header.type != Texture::UNSIGNED_BYTE) || !header.levelCount ||
+				// built for other settings, e.g. raw levels for a texture now set to BC1
+				memcmp(&header.settings, &settings, sizeof(Settings)) ||
+				entry.getSize() < sizeof(Header) + header.levelCount * sizeof(Level))
+				return false;
+			// a touched but unchanged source, e.g. after a fresh checkout, keeps its entry
+			if (header.sourceTime != time || header.sourceSize != size)
+			{
+				if (header.sourceSize != size || header.sourceHash != hashFile(filename))
+					return false;
+				touched = true;
+			}
+
+			Texture::PixelType type = (Texture::PixelType)header.type;
+			Texture::Compression compression = (Texture::Compression)header.compression;
+			std::vector<const unsigned char*> levels;
+			for (uint32_t i = 0; i < header.levelCount; i++)
+			{
+				Level level;
+				memcpy(&level, data + sizeof(Header) + i * sizeof(Level), sizeof(Level));
+				int levelWidth = header.width >> i > 0 ? header.width >> i : 1;
+				int levelHeight = header.height >> i > 0 ? header.height >> i : 1;
+				if (level.size != Texture::getLevelSize(levelWidth, levelHeight, header.channel, type, compression) || level.offset + level.size > entry.getSize())
+					return false;
+				levels.push_back(data + level.offset);
+			}
+			texture.generateLevels(header.width, header.height, header.channel, type, levels, compression);
+		}
+
+		// refresh the time so the next run skips the hash
+		if (touched)
+		{
+			std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+			f.seekp(offsetof(Header, sourceTime));
+			f.write((const char*)&time, sizeof(time));
+		}
+		return true;
+	}
+
+	std::vector<std::vector<unsigned char>> TextureCache::readBack(Texture& texture)
+	{
+		int width = texture.getWidth(), height = texture.getHeight();
+		Texture::Compression compression = texture.getCompression();
+		uint32_t levelCount = 1;
+		if (texture.isMipmapEnabled())
+			while (width >> levelCount || height >> levelCount)
+				levelCount++;
+
+		std::vector<std::vector<unsigned char>> levels(levelCount);
+		GLState::bindTexture(0, texture.getHandle());
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		for (uint32_t i = 0; i < levelCount; i++)
+		{
+			int levelWidth = width >> i > 0 ? width >> i : 1;
+			int levelHeight = height >> i > 0 ? height >> i : 1;
+			levels[i].resize(Texture::getLevelSize(levelWidth, levelHeight, texture.getChannel(), texture.getPixelType(), compression));
+			if (compression == Texture::RAW)
+				glGetTexImage(GL_TEXTURE_2D, i, Texture::getFormatGL(texture.getChannel()), Texture::getTypeGL(texture.getPixelType()), levels[i].data());
+			else
+				glGetCompressedTexImage(GL_TEXTURE_2D, i, levels[i].data());
+		}
+		return levels;
+	}
+
+	void TextureCache::write(Texture& texture, const char* filename, const std::vector<const unsigned char*>& levels)
+	{
+		Header header;
+		memcpy(header.magic, "XGLT", 4);
+		header.version = version;
+		header.width = texture.getWidth();
+		header.height = texture.getHeight();
+		header.channel = texture.getChannel();
+		header.type = texture.getPixelType();
+		header.compression = texture.getCompression();
+		header.settings = settingsOf(texture);
+		header.levelCount = (uint32_t)levels.size();
+		if (!sourceInfo(filename, header.sourceTime, header.sourceSize))
+		{
+			std::cerr << "ERROR | XGL::TextureCache::store(Texture&, const char*) : Failed to open file \"" << filename << "\".\n";
+			throw Texture::FILE_OPEN_FAIL;
+		}
+		header.sourceHash = hashFile(filename);
+
+		std::vector<Level> table(header.levelCount);
+		uint64_t offset = sizeof(Header) + header.levelCount * sizeof(Level);
+		for (uint32_t i = 0; i < header.levelCount; i++)
+		{
+			int levelWidth = header.width >> i > 0 ? header.width >> i : 1;
+			int levelHeight = header.height >> i > 0 ? header.height >> i : 1;
+			table[i].offset = offset;
+			table[i].size = Texture::getLevelSize(levelWidth, levelHeight, header.channel, texture.getPixelType(), texture.getCompression());
+			offset += table[i].size;
+		}
+
+		// written aside and renamed, a crash never leaves a truncated entry behind
+		std::string path = entryPath(filename, header.settings);
+		std::string temp = path + ".tmp";
+		{
+			std::ofstream f(temp, std::ios::binary | std::ios::trunc);
+			f.write((const char*)&header, sizeof(Header));
+			f.write((const char*)table.data(), table.size() * sizeof(Level));
+			for (uint32_t i = 0; i < header.levelCount; i++)
+				f.write((const char*)levels[i], table[i].size);
+			if (!f)
+			{
+				std::cerr << "ERROR | XGL::TextureCache::store(Texture&, const char*) : Failed to write \"" << temp << "\".\n";
+				throw WRITE_FAIL;
+			}
+		}
+		std::error_code error;
+		std::filesystem::rename(temp, path, error);
+		if (error)
+		{
+			std::cerr << "ERROR | XGL::TextureCache::store(Texture&, const char*) : Failed to write \"" << path << "\".\n";
+			throw WRITE_FAIL;
+		}
+	}
+
+	void TextureCache::store(Texture& texture, const char* filename)
+	{
+		if (texture.pending.valid())
+			texture.finishLoad();
+
+		// a chain left to glGenerateMipmap only exists on the GPU, once generated it is kept as the driver built it
+		bool driverChain = texture.isMipmapEnabled() && texture.getMipmapFilter() == Texture::DRIVER && texture.getCompression() == Texture::RAW;
+		if (texture.isGenerated() && (driverChain || !texture.getData()))
+		{
+			std::vector<std::vector<unsigned char>> levels = readBack(texture);
+			std::vector<const unsigned char*> pointers;
+			for (size_t i = 0; i < levels.size(); i++)
+				pointers.push_back(levels[i].data());
+			write(texture, filename, pointers);
+			return;
+		}
+		if (!texture.getData())
+		{
+			std::cerr << "ERROR | XGL::TextureCache::store(Texture&, const char*) : No image data.\n";
+			throw Texture::NO_IMAGE_DATA;
+		}
+
+		std::vector<std::vector<unsigned char>> blocks;
+		write(texture, filename, texture.buildLevels(blocks));
+	}
+
+	void TextureCache::get(Texture& texture, const char* filename)
+	{
+		if (load(texture, filename))
+			return;
+		texture.load(filename);
+		// the levels are built once, for the entry and for the upload
+		std::vector<std::vector<unsigned char>> blocks;
+		std::vector<const unsigned char*> levels = texture.buildLevels(blocks);
+		write(texture, filename, levels);
+		texture.upload(levels, texture.getCompression());
+	}
+}
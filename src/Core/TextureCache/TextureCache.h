@@ -0,0 +1,84 @@
+#ifndef XGL_TEXTURECACHE_H
+#define XGL_TEXTURECACHE_H
+
+#include "Texture/Texture.h"
+#include <glad/glad.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace XGL
+{
+	// Decoded and mipmapped textures kept on disk, one file per source image, so later runs skip stb_image and mipmap generation,
+	// and for block compressed textures the encoder as well. Entries are written from the CPU copy of the texture, so a cache
+	// can be filled offline without a GL context.
+	// An entry is keyed by the source path and the Texture settings it was built with, so that differently set up
+	// textures of one image get their own entries, and is valid while the source keeps its size and modification time,
+	// or, when those changed, while its content hash still matches. Entries are read through a memory mapping and
+	// uploaded level by level straight from it.
+	class TextureCache
+	{
+		public:
+			enum ERROR { WRITE_FAIL };
+
+			static const uint32_t version = 4;
+
+		private:
+			// the Texture settings shaping an entry, part of its key
+			typedef struct
+			{
+				int32_t compression;	// Texture::getCompressionSetting()
+				int32_t mipmapEnabled;
+				int32_t mipmapFilter;	// Texture::MipmapFilter
+				int32_t sRGB;
+			} Settings;
+
+			// on-disk layout: Header, then levelCount Level records, then the texel data of every level
+			typedef struct
+			{
+				char magic[4];			// "XGLT"
+				uint32_t version;
+				int32_t width;
+				int32_t height;
+				int32_t channel;
+				int32_t type;			// Texture::PixelType
+				int32_t compression;	// Texture::Compression of the stored levels
+				Settings settings;
+				uint32_t levelCount;
+				int64_t sourceTime;
+				uint64_t sourceSize;
+				uint64_t sourceHash;
+			} Header;
+
+			typedef struct
+			{
+				uint64_t offset;		// from the start of the file
+				uint64_t size;
+			} Level;
+
+			std::string directory;
+
+			static Settings settingsOf(Texture& texture);
+			std::string entryPath(const char* filename, const Settings& settings);
+			static bool sourceInfo(const char* filename, int64_t& time, uint64_t& size);
+			static uint64_t hashFile(const char* filename);
+			// levels are the whole chain, or only the base level when the driver builds the rest on load
+			void write(Texture& texture, const char* filename, const std::vector<const unsigned char*>& levels);
+			// the levels of the GL texture, for a chain only the driver knows
+			static std::vector<std::vector<unsigned char>> readBack(Texture& texture);
+
+		public:
+			TextureCache(const char* directory);
+
+			// uploads the cached entry into texture, false if there is no valid one
+			bool load(Texture& texture, const char* filename);
+			// writes the entry of a loaded texture from its pixels, CPU mip chain and blocks as generate() would upload them;
+			// DRIVER mipmaps of a generated texture, and a generated texture whose pixels were released, are read back from GL
+			void store(Texture& texture, const char* filename);
+			// load(), or a regular load, store() and the upload of the levels store() built
+			void get(Texture& texture, const char* filename);
+	};
+}
+
+#endif // !XGL_TEXTURECACHE_H
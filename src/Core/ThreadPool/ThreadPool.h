@@ -0,0 +1,52 @@
+#ifndef XGL_THREADPOOL_H
+#define XGL_THREADPOOL_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace XGL
+{
+	// Fixed set of worker threads taking jobs first in, first out. Jobs must not touch GL, no context is current on the workers.
+	class ThreadPool
+	{
+		private:
+			std::vector<std::thread> workers;
+			std::queue<std::function<void()>> jobs;
+			std::mutex mutex;
+			std::condition_variable available;
+			bool stopping;
+
+			void work();
+
+		public:
+			// 0 picks the hardware concurrency less one, the GL thread keeps a core
+			ThreadPool(unsigned int threadCount = 0);
+			ThreadPool(const ThreadPool&) = delete;
+			ThreadPool& operator=(const ThreadPool&) = delete;
+			// finishes the queued jobs first
+			~ThreadPool();
+
+			template<typename F>
+			std::future<typename std::invoke_result<F>::type> submit(F&& job);
+
+			// fn(first, last) over [begin, end) cut into one range per worker and one for the calling thread,
+			// ranges are at least minChunk long and with fewer than 2 * minChunk items fn runs once on the caller;
+			// returns when every range is done, so it must not be called from the pool's own workers
+			template<typename F>
+			void parallelFor(int begin, int end, int minChunk, F&& fn);
+
+			size_t getThreadCount() { return workers.size(); }
+
+			// shared by the loaders of XGL, started on first use
+			static ThreadPool& global();
+	};
+}
+
+#include "ThreadPool.inl"
+
+#endif // !XGL_THREADPOOL_H
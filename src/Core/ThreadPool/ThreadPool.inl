@@ -0,0 +1,52 @@
+#ifndef XGL_THREADPOOL_INL
+#define XGL_THREADPOOL_INL
+
+#include "ThreadPool.h"
+
+#include <memory>
+
+namespace XGL
+{
+	template<typename F>
+	std::future<typename std::invoke_result<F>::type> ThreadPool::submit(F&& job)
+	{
+		typedef typename std::invoke_result<F>::type R;
+		// std::function needs a copyable target, the task itself is move only
+		auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(job));
+		std::future<R> res = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			jobs.push([task]() { (*task)(); });
+		}
+		available.notify_one();
+		return res;
+	}
+
+	template<typename F>
+	void ThreadPool::parallelFor(int begin, int end, int minChunk, F&& fn)
+	{
+		int count = end - begin;
+		int threadCount = (int)getThreadCount() + 1;
+		if (threadCount > count / minChunk)
+			threadCount = count / minChunk;
+		if (threadCount <= 1)
+		{
+			fn(begin, end);
+			return;
+		}
+
+		int chunk = (count + threadCount - 1) / threadCount;
+		std::vector<std::future<void>> ranges;
+		for (int first = begin + chunk; first < end; first += chunk)
+		{
+			int last = first + chunk < end ? first + chunk : end;
+			ranges.push_back(submit([&fn, first, last]() { fn(first, last); }));
+		}
+		// the calling thread takes the first range instead of idling
+		fn(begin, begin + chunk);
+		for (size_t i = 0; i < ranges.size(); i++)
+			ranges[i].get();
+	}
+}
+
+#endif // !XGL_THREADPOOL_INL
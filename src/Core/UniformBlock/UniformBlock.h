@@ -0,0 +1,75 @@
+#ifndef XGL_UNIFORMBLOCK_H
+#define XGL_UNIFORMBLOCK_H
+
+#include <glad/glad.h>
+#include <Math/Vector.h>
+#include <Math/Matrix.h>
+#include "GLState/GLState.h"
+#include <cstddef>
+#include <type_traits>
+
+// compile-time check that a member of a UniformBlock struct sits where std140 puts it
+#define XGL_STD140_MEMBER(Block, member) \
+	static_assert(XGL::Std140<decltype(Block::member)>::supported, \
+		#Block "::" #member " has a type without a matching std140 layout"); \
+	static_assert(offsetof(Block, member) % XGL::Std140<decltype(Block::member)>::alignment == 0, \
+		#Block "::" #member " is not aligned as std140 requires")
+
+namespace XGL
+{
+	// std140 base alignment of the C++ types whose memory layout matches their GLSL counterpart.
+	// Mat2 and Mat3 are left out: std140 pads each of their columns to a vec4.
+	template<typename T>
+	struct Std140 { static const bool supported = false; static const size_t alignment = 1; };
+	template<>
+	struct Std140<float> { static const bool supported = true; static const size_t alignment = 4; };
+	template<>
+	struct Std140<int> { static const bool supported = true; static const size_t alignment = 4; };
+	template<>
+	struct Std140<unsigned int> { static const bool supported = true; static const size_t alignment = 4; };
+	template<>
+	struct Std140<Vec2> { static const bool supported = true; static const size_t alignment = 8; };
+	template<>
+	struct Std140<Vec3> { static const bool supported = true; static const size_t alignment = 16; };
+	template<>
+	struct Std140<Vec4> { static const bool supported = true; static const size_t alignment = 16; };
+	template<>
+	struct Std140<Mat4> { static const bool supported = true; static const size_t alignment = 16; };
+
+	// A uniform buffer holding one T, read through a fixed binding point while bound. T is laid out as the std140 GLSL block;
+	// check its members with XGL_STD140_MEMBER. Programs pick it up through Program::bindUniformBlock().
+	template<typename T>
+	class UniformBlock
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "UniformBlock needs a trivially copyable struct");
+		static_assert(sizeof(T) % 16 == 0, "UniformBlock struct must be padded to a multiple of 16 bytes as in std140");
+
+		private:
+			unsigned int handle;
+			unsigned int binding;
+			T data;
+			bool dirty;
+
+		public:
+			UniformBlock(unsigned int binding);
+			UniformBlock(const UniformBlock<T>&) = delete;
+			UniformBlock<T>& operator=(const UniformBlock<T>&) = delete;
+			~UniformBlock();
+
+			const T& get() const { return data; }
+			// the block is uploaded on the next upload()
+			T& edit() { dirty = true; return data; }
+			void set(const T& value) { data = value; dirty = true; }
+			// sends the block if it was changed since the last upload
+			void upload();
+			// makes this block the one read at its binding point, other blocks may share the point
+			void bind();
+
+			unsigned int getHandle() { return handle; }
+			unsigned int getBinding() { return binding; }
+	};
+}
+
+#include "UniformBlock.inl"
+
+#endif // !XGL_UNIFORMBLOCK_H
@@ -0,0 +1,40 @@
+#ifndef XGL_UNIFORMBLOCK_INL
+#define XGL_UNIFORMBLOCK_INL
+
+#include "UniformBlock.h"
+
+namespace XGL
+{
+	template<typename T>
+	UniformBlock<T>::UniformBlock(unsigned int binding) : binding(binding), data(), dirty(true)
+	{
+		glGenBuffers(1, &handle);
+		GLState::bindBuffer(GL_UNIFORM_BUFFER, handle);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(T), NULL, GL_DYNAMIC_DRAW);
+	}
+
+	template<typename T>
+	UniformBlock<T>::~UniformBlock()
+	{
+		GLState::forgetBuffer(handle);
+		glDeleteBuffers(1, &handle);
+	}
+
+	template<typename T>
+	void UniformBlock<T>::upload()
+	{
+		if (!dirty)
+			return;
+		GLState::bindBuffer(GL_UNIFORM_BUFFER, handle);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(T), &data);
+		dirty = false;
+	}
+
+	template<typename T>
+	void UniformBlock<T>::bind()
+	{
+		GLState::bindUniformBuffer(binding, handle);
+	}
+}
+
+#endif // !XGL_UNIFORMBLOCK_INL
@@ -8,6 +8,7 @@
 #include <Texture/Texture.h>
 #include <Program/Program.h>
 #include <Object/Object.h>
+#include <InstanceBuffer/InstanceBuffer.h>
 #include <stb_image.h>
 #include <iostream>
 #include <fstream>
@@ -222,7 +223,7 @@ int main()
     object.addTexture(texture2, "texture1", 1);
 
     //load glsl programs
-    Shader<ShaderType::VERTEX> vertexShader("../src/Test/shaders/shader.vert");
+    Shader<ShaderType::VERTEX> vertexShader("../src/Test/shaders/instanced.vert");
     Shader<ShaderType::FRAGMENT> fragmentShader("../src/Test/shaders/shader.frag");
 
     //compile glsl program
@@ -236,6 +237,11 @@ int main()
     program.attachShader(fragmentShader);
     program.link();
 
+    //one instance per cube
+    InstanceBuffer instances;
+    for (int i = 0; i < 10; i++)
+        instances.add(positions[i], Quat::fromAxisAngle(i, Vec3(1, 0.5, 0.3)), Vec3(1, 1, 1));
+
     while (!glfwWindowShouldClose(window))
     {
         float currentFrame = glfwGetTime();
@@ -249,13 +255,7 @@ int main()
 
         program.updateCamera(deltaTime);
 
-        for (int i = 0; i < 10; i++)
-        {
-            object.setPosition(positions[i]);
-            object.setRotation(i, Vec3(1, 0.5, 0.3));
-            object.setScaling(1);
-            program.draw(object);
-        }
+        program.drawInstanced(object, instances);
 
         glfwSwapBuffers(window);
         glfwPollEvents();
@@ -0,0 +1,19 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in mat4 aModel;
+
+out vec2 io_texCoord;
+
+layout (std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+};
+
+void main()
+{
+    gl_Position = viewProjection * aModel * vec4(aPos, 1.0);
+    io_texCoord = aTexCoord;
+}